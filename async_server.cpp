@@ -0,0 +1,231 @@
+//--------------------------
+// Async server module
+//--------------------------
+// Description:
+// Coroutine (C++20) API on top of server_socket: co_await accept(), read_frame() and write()
+// on an event loop driven by server_socket::s_poll()
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#include "async_server.h"
+
+//-----------------------------
+// Class: async_connection
+//-----------------------------
+
+bool async_connection::valid(){
+        return loop != nullptr && loop->server.client_valid(handle);
+}
+
+int async_connection::number(){
+        return (int) handle.index;
+}
+
+void async_connection::close(){
+        if ( !valid() ) {
+                return;
+        }
+        int fd = loop->server.client_fd(number());
+        loop->server.remove_client(number());
+        ::close(fd);
+}
+
+// Buffered messages are handed out without going through the loop
+bool async_connection::read_awaiter::await_ready(){
+        if ( !connection->valid() ) {
+                connection->read_error = EBADF;
+                return true;
+        }
+        frame_view next;
+        if ( connection->loop->server.next_frame(connection->number(), next) ) {
+                frame = next;
+                return true;
+        }
+        return false;
+}
+
+void async_connection::read_awaiter::await_suspend(std::coroutine_handle<> h){
+        waiting = h;
+        connection->loop->read_waiters[connection->number()] = this;
+}
+
+bool async_connection::write_awaiter::attempt(){
+        if ( !connection->valid() ) {
+                result = -1;
+                error = EPIPE;
+                return true;
+        }
+        if ( connection->loop->server.s_write(connection->number(), data, length) == 0 ) {
+                result = 0;
+                error = 0;
+                return true;
+        }
+        if (errno == ENOBUFS) {
+                // Over the high watermark, wait for the queue to drain
+                return false;
+        }
+        result = -1;
+        error = errno;
+        return true;
+}
+
+void async_connection::write_awaiter::await_suspend(std::coroutine_handle<> h){
+        waiting = h;
+        connection->loop->write_waiters.push_back(this);
+}
+
+//-----------------------------
+// Class: async_server
+//-----------------------------
+
+async_server::async_server(server_socket& s) : running(false), server(s) {
+}
+
+async_server::~async_server(){
+        // Suspended coroutines never finish, free their frames (and the tasks they await)
+        std::vector<void*> remaining(spawned.begin(), spawned.end());
+        for (void* address : remaining) {
+                std::coroutine_handle<>::from_address(address).destroy();
+        }
+}
+
+void async_server::accept_awaiter::await_suspend(std::coroutine_handle<> h){
+        waiting = h;
+        loop->accept_waiters.push_back(this);
+}
+
+async_server::detached async_server::run_detached(async_server* loop, task<void> body){
+        co_await body;
+}
+
+void async_server::detached::promise_type::unhandled_exception() noexcept {
+        RSOCKET_LOG_ERROR("Unhandled exception in a coroutine spawned on async_server");
+}
+
+async_server::detached::promise_type::~promise_type(){
+        loop->spawned.erase(std::coroutine_handle<promise_type>::from_promise(*this).address());
+}
+
+void async_server::spawn(task<void> body){
+        detached coroutine = run_detached(this, std::move(body));
+        spawned.insert(coroutine.coroutine.address());
+        ready.push_back(coroutine.coroutine);
+}
+
+void async_server::accept_clients(){
+        while ( !accept_waiters.empty() && server.s_accept_pending() ) {
+                int fd = server.s_accept();
+                if (fd < 0) {
+                        if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                                int errsv = errno;
+                                RSOCKET_LOG_ERROR("Failed to accept client connection (errno %d)", errsv);
+                        }
+                        continue;
+                }
+                int client_number = server.fd_client(fd);
+                accept_awaiter* waiter = accept_waiters.front();
+                accept_waiters.pop_front();
+                waiter->connection = async_connection(this, server.get_client_handle(client_number));
+                ready.push_back(waiter->waiting);
+        }
+}
+
+void async_server::read_clients(){
+        ready_clients.clear();
+        server.s_ready_clients(ready_clients);
+        for (int client_number : ready_clients) {
+                auto found = read_waiters.find(client_number);
+                if (found == read_waiters.end()) {
+                        // Its coroutine is busy elsewhere, the client stays listed until it reads
+                        continue;
+                }
+                async_connection::read_awaiter* waiter = found->second;
+
+                long num_bytes = server.s_read_frames(client_number);
+                int errsv = errno;
+                frame_view frame;
+                if ( server.next_frame(client_number, frame) ) {
+                        waiter->frame = frame;
+                } else if (num_bytes == 0) {
+                        waiter->connection->read_error = 0;
+                } else if (num_bytes < 0 && errsv != EAGAIN && errsv != EWOULDBLOCK) {
+                        waiter->connection->read_error = errsv;
+                } else {
+                        // Partial message, keep waiting
+                        continue;
+                }
+                read_waiters.erase(found);
+                ready.push_back(waiter->waiting);
+        }
+}
+
+void async_server::write_clients(){
+        size_t kept = 0;
+        for (size_t i = 0; i < write_waiters.size(); i++) {
+                async_connection::write_awaiter* waiter = write_waiters[i];
+                if ( waiter->connection->valid() && !server.s_writable(waiter->connection->number()) ) {
+                        write_waiters[kept++] = waiter;
+                        continue;
+                }
+                if ( !waiter->attempt() ) {
+                        write_waiters[kept++] = waiter;
+                        continue;
+                }
+                ready.push_back(waiter->waiting);
+        }
+        write_waiters.resize(kept);
+}
+
+int async_server::run_once(int timeout){
+        // Resume everything that became ready, they may queue more work for this same pass
+        while ( !ready.empty() ) {
+                std::coroutine_handle<> next = ready.front();
+                ready.pop_front();
+                next.resume();
+        }
+
+        // Don't sleep while an earlier edge left work for a waiting coroutine
+        bool pending = ( !accept_waiters.empty() && server.s_accept_pending() );
+        if (!pending) {
+                ready_clients.clear();
+                server.s_ready_clients(ready_clients);
+                for (int client_number : ready_clients) {
+                        if ( read_waiters.count(client_number) ) {
+                                pending = true;
+                                break;
+                        }
+                }
+        }
+        if ( server.s_poll(pending ? 0 : timeout) < 0 ) {
+                int errsv = errno;
+                RSOCKET_LOG_ERROR("Event loop failed (errno %d)", errsv);
+                errno = errsv;
+                return -1;
+        }
+
+        accept_clients();
+        read_clients();
+        write_clients();
+        return 0;
+}
+
+int async_server::run(){
+        running = true;
+        while (running) {
+                if ( run_once(DEFAULT_ASYNC_POLL_TIMEOUT) < 0 ) {
+                        running = false;
+                        return errno;
+                }
+        }
+        return 0;
+}
+
+void async_server::stop(){
+        running = false;
+}
@@ -0,0 +1,186 @@
+//--------------------------
+// Async server module header
+//--------------------------
+// Description:
+// Coroutine (C++20) API on top of server_socket: co_await accept(), read_frame() and write()
+// on an event loop driven by server_socket::s_poll()
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#ifndef _async_server_H_INCLUDED
+#define _async_server_H_INCLUDED
+
+// Default settings
+//-----------------------------
+// Longest run() sleeps (ms) while no coroutine can make progress, bounds how late stop() from another thread is seen
+#define DEFAULT_ASYNC_POLL_TIMEOUT 100
+//-----------------------------
+
+// Includes
+//-----------------------------
+// Standard libraries
+#include <atomic>
+#include <coroutine>
+#include <deque>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "logger.h"
+#include "server_socket.h"
+#include "task.h"
+//-----------------------------
+
+class async_server;
+
+// One accepted client, a cheap handle that can be copied into the coroutine serving it
+class async_connection
+{
+    private:
+        async_server* loop = nullptr;
+        client_handle handle = {0, 0};
+
+    public:
+        struct read_awaiter
+        {
+                async_connection* connection;
+                std::optional<frame_view> frame;
+                std::coroutine_handle<> waiting;
+
+                bool await_ready();
+                void await_suspend(std::coroutine_handle<> h);
+                std::optional<frame_view> await_resume() { return frame; }
+        };
+
+        struct write_awaiter
+        {
+                async_connection* connection;
+                const char* data;
+                size_t length;
+                int result = 0;
+                int error = 0;
+                std::coroutine_handle<> waiting;
+
+                // Queue the message, false while the output queue is over the high watermark
+                bool attempt();
+                bool await_ready() { return attempt(); }
+                void await_suspend(std::coroutine_handle<> h);
+                int await_resume() {
+                        errno = error;
+                        return result;
+                }
+        };
+
+        // Error that ended the last read_frame() (0 for a clean close)
+        int read_error = 0;
+
+        async_connection() {}
+        async_connection(async_server* l, client_handle h) : loop(l), handle(h) {}
+
+        // False once closed (or for a failed accept())
+        bool valid();
+
+        // Client number on the underlying server_socket
+        int number();
+
+        // co_await read_frame(): the next complete message, std::nullopt when the client closed or failed (see read_error)
+        // The view is valid until the next read_frame() on this connection
+        read_awaiter read_frame() { return read_awaiter{this, std::nullopt, nullptr}; }
+
+        // co_await write(): 0, or -1 (errno set) if the client is gone
+        // Suspends only while the client's output queue is over the high watermark, data must stay valid until then
+        write_awaiter write(const char* data, size_t length) { return write_awaiter{this, data, length}; }
+
+        // Remove the client and close its socket
+        void close();
+};
+
+// Single-threaded event loop, every coroutine spawned on it runs on the thread that calls run()
+// The poll-style server_socket API keeps working on the same server, but don't mix the two for one client
+class async_server
+{
+    private:
+        friend class async_connection;
+
+        struct accept_awaiter
+        {
+                async_server* loop;
+                async_connection connection;
+                std::coroutine_handle<> waiting;
+
+                bool await_ready() { return false; }
+                void await_suspend(std::coroutine_handle<> h);
+                async_connection await_resume() { return connection; }
+        };
+
+        // Fire-and-forget coroutine behind spawn(), owned by the loop until it finishes
+        struct detached
+        {
+                struct promise_type
+                {
+                        async_server* loop;
+
+                        promise_type(async_server* l, task<void>&) : loop(l) {}
+                        detached get_return_object() {
+                                return detached{std::coroutine_handle<promise_type>::from_promise(*this)};
+                        }
+                        std::suspend_always initial_suspend() noexcept { return {}; }
+                        std::suspend_never final_suspend() noexcept { return {}; }
+                        void return_void() noexcept {}
+                        void unhandled_exception() noexcept;
+                        ~promise_type();
+                };
+                std::coroutine_handle<promise_type> coroutine;
+        };
+        static detached run_detached(async_server* loop, task<void> body);
+
+        std::atomic<bool> running;
+        // Coroutines ready to continue, resumed by run_once() in order
+        std::deque<std::coroutine_handle<>> ready;
+        std::deque<accept_awaiter*> accept_waiters;
+        // Keyed by client number, one reader per client
+        std::unordered_map<int, async_connection::read_awaiter*> read_waiters;
+        std::vector<async_connection::write_awaiter*> write_waiters;
+        // Spawned coroutines still running, destroyed with the loop
+        std::unordered_set<void*> spawned;
+        std::vector<int> ready_clients;
+
+        void accept_clients();
+        void read_clients();
+        void write_clients();
+
+    public:
+        // Must be initialized (s_init()) before run()
+        server_socket& server;
+
+        explicit async_server(server_socket& s);
+        ~async_server();
+
+        async_server(const async_server&) = delete;
+        async_server& operator=(const async_server&) = delete;
+
+        // co_await accept(): the next client, always valid
+        accept_awaiter accept() { return accept_awaiter{this, async_connection(), nullptr}; }
+
+        // Run body on the loop, starting from the next run_once()
+        void spawn(task<void> body);
+
+        // One loop iteration: resume ready coroutines, wait up to timeout ms for events, complete awaits
+        // Returns 0 or -1 (errno set)
+        int run_once(int timeout);
+
+        // Loop until stop(), returns 0 or the errno that ended it
+        int run();
+
+        // Safe from any thread and from inside coroutines
+        void stop();
+};
+
+#endif // async_server.h
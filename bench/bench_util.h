@@ -0,0 +1,153 @@
+//--------------------------
+// Benchmark utilities header
+//--------------------------
+// Description:
+// Timing, percentile and JSON output helpers shared by rsocket_bench and rsocket_loadgen
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#ifndef _bench_util_H_INCLUDED
+#define _bench_util_H_INCLUDED
+
+// Includes
+//-----------------------------
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+//-----------------------------
+
+inline uint64_t bench_now_ns(){
+        return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Value of --name (or fallback), flags without a value are not supported
+inline const char* bench_arg(int argc, char** argv, const char* name, const char* fallback){
+        for (int i = 1; i + 1 < argc; i++) {
+                if (std::strcmp(argv[i], name) == 0) {
+                        return argv[i + 1];
+                }
+        }
+        return fallback;
+}
+
+inline long long bench_arg_int(int argc, char** argv, const char* name, long long fallback){
+        const char* value = bench_arg(argc, argv, name, nullptr);
+        return value ? std::strtoll(value, nullptr, 10) : fallback;
+}
+
+inline bool bench_flag(int argc, char** argv, const char* name){
+        for (int i = 1; i < argc; i++) {
+                if (std::strcmp(argv[i], name) == 0) {
+                        return true;
+                }
+        }
+        return false;
+}
+
+// Latency distribution in microseconds
+struct latency_summary
+{
+        double p50 = 0;
+        double p99 = 0;
+        double p999 = 0;
+        double mean = 0;
+        double max = 0;
+};
+
+// Sorts samples (nanoseconds) in place
+inline latency_summary summarize(std::vector<uint64_t>& samples){
+        latency_summary summary;
+        if (samples.empty()) {
+                return summary;
+        }
+        std::sort(samples.begin(), samples.end());
+        auto at = [&](double q) {
+                size_t index = (size_t) (q * (double) (samples.size() - 1));
+                return (double) samples[index] / 1000.0;
+        };
+        double total = 0;
+        for (uint64_t sample : samples) {
+                total += (double) sample;
+        }
+        summary.p50 = at(0.50);
+        summary.p99 = at(0.99);
+        summary.p999 = at(0.999);
+        summary.mean = total / (double) samples.size() / 1000.0;
+        summary.max = (double) samples.back() / 1000.0;
+        return summary;
+}
+
+// One flat JSON object, printed as a single line (JSON Lines) so results can be appended and grepped
+class json_line
+{
+    private:
+        std::string text = "{";
+
+        void key(const char* name){
+                if (text.size() > 1) {
+                        text += ",";
+                }
+                text += "\"";
+                text += name;
+                text += "\":";
+        }
+
+    public:
+        json_line& add(const char* name, const char* value){
+                key(name);
+                text += "\"";
+                for (const char* c = value; *c; c++) {
+                        if (*c == '"' || *c == '\\') {
+                                text += '\\';
+                        }
+                        text += *c;
+                }
+                text += "\"";
+                return *this;
+        }
+
+        json_line& add(const char* name, uint64_t value){
+                char number[32];
+                snprintf(number, sizeof(number), "%" PRIu64, value);
+                key(name);
+                text += number;
+                return *this;
+        }
+
+        json_line& add(const char* name, double value){
+                char number[32];
+                snprintf(number, sizeof(number), "%.3f", value);
+                key(name);
+                text += number;
+                return *this;
+        }
+
+        json_line& add(const char* name, const latency_summary& latency){
+                std::string prefix(name);
+                add((prefix + "_p50_us").c_str(), latency.p50);
+                add((prefix + "_p99_us").c_str(), latency.p99);
+                add((prefix + "_p999_us").c_str(), latency.p999);
+                add((prefix + "_mean_us").c_str(), latency.mean);
+                add((prefix + "_max_us").c_str(), latency.max);
+                return *this;
+        }
+
+        void print(){
+                printf("%s}\n", text.c_str());
+                fflush(stdout);
+        }
+};
+
+#endif // bench_util.h
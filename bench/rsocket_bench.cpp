@@ -0,0 +1,486 @@
+//--------------------------
+// rsocket_bench
+//--------------------------
+// Description:
+// Loopback benchmarks for server_socket / client_socket: accept rate, echo round-trip latency,
+// small-message throughput and large-transfer bandwidth. Results are printed as JSON Lines
+// --serve runs the echo server alone (for rsocket_loadgen or other clients)
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+// Default settings
+//-----------------------------
+#define BENCH_DEFAULT_PORT 9950
+// Messages per c_write_batch() in the throughput benchmark
+#define BENCH_BATCH 64
+// Echo round trips excluded from the latency numbers
+#define BENCH_WARMUP 1000
+//-----------------------------
+
+// Includes
+//-----------------------------
+#include <atomic>
+#include <csignal>
+#include <thread>
+
+#include "client_socket.h"
+#include "logger.h"
+#include "metrics.h"
+#include "recv_buffer.h"
+#include "server_socket.h"
+
+#include "bench_util.h"
+//-----------------------------
+
+static void usage(){
+        fprintf(stderr,
+                "usage: rsocket_bench [--scenario all|accept|echo|throughput|bandwidth] [--port N] [--engine epoll|uring]\n"
+                "                     [--wait timed|blocking|busy|adaptive] [--connections N] [--messages N]\n"
+                "                     [--size BYTES] [--bytes TOTAL] [--profile default|latency|throughput]\n"
+                "       rsocket_bench --serve [--port N] [--engine epoll|uring] [--wait timed|blocking|busy|adaptive]\n"
+                "                             [--profile default|latency|throughput]\n");
+}
+
+// Server side of every benchmark: echoes messages back, or only counts them
+class bench_server
+{
+    private:
+        server_socket server;
+        std::thread thread;
+        bool echo = false;
+
+        void run(){
+                std::vector<int> ready;
+                while ( !stop.load(std::memory_order_relaxed) ) {
+                        // Don't sleep while accepts were cut short by s_accept_limit
+                        if ( server.s_poll(server.s_accept_pending() ? 0 : 10) < 0 ) {
+                                break;
+                        }
+                        if ( server.s_accept_pending() ) {
+                                accepted.fetch_add((uint64_t) server.s_accept_all(), std::memory_order_relaxed);
+                        }
+
+                        ready.clear();
+                        server.s_ready_clients(ready);
+                        for (int client_number : ready) {
+                                long num_bytes = server.s_read_frames(client_number);
+                                int errsv = errno;
+                                uint64_t count = 0;
+                                frame_view frame;
+                                while ( server.next_frame(client_number, frame) ) {
+                                        count++;
+                                        if ( echo && server.s_write(client_number, frame.data, frame.size) < 0 ) {
+                                                dropped.fetch_add(1, std::memory_order_relaxed);
+                                        }
+                                }
+                                messages.fetch_add(count, std::memory_order_relaxed);
+                                if (num_bytes == 0 || (num_bytes < 0 && errsv != EAGAIN && errsv != EWOULDBLOCK)) {
+                                        int fd = server.client_fd(client_number);
+                                        server.remove_client(client_number);
+                                        close(fd);
+                                }
+                        }
+                }
+        }
+
+    public:
+        std::atomic<bool> stop{false};
+        std::atomic<uint64_t> accepted{0};
+        std::atomic<uint64_t> messages{0};
+        // Echoes refused because the client's output queue was full
+        std::atomic<uint64_t> dropped{0};
+
+        int start(uint16_t port, io_engine engine, wait_strategy wait, const socket_options& tuning, bool echo_messages){
+                echo = echo_messages;
+                server.s_port = port;
+                server.s_engine = engine;
+                server.s_wait = wait;
+                server.s_options = tuning;
+                server.s_framing = FRAMING_AUTO;
+                server.s_bind_address = htonl(INADDR_LOOPBACK);
+                if ( server.s_init() != 0 ) {
+                        return -1;
+                }
+                thread = std::thread(&bench_server::run, this);
+                return 0;
+        }
+
+        void finish(){
+                stop = true;
+                if ( thread.joinable() ) {
+                        thread.join();
+                }
+        }
+
+        const char* engine_name(){
+                return server.s_active_engine() == ENGINE_URING ? "uring" : "epoll";
+        }
+
+        const char* wait_name(){
+                const char* names[] = {"timed", "blocking", "busy", "adaptive"};
+                return names[server.s_wait];
+        }
+
+        // Spin until the server has counted target messages, false after timeout_s seconds
+        bool wait_messages(uint64_t target, double timeout_s){
+                uint64_t deadline = bench_now_ns() + (uint64_t) (timeout_s * 1e9);
+                while (messages.load(std::memory_order_relaxed) < target) {
+                        if (bench_now_ns() > deadline) {
+                                return false;
+                        }
+                        std::this_thread::yield();
+                }
+                return true;
+        }
+};
+
+struct bench_options
+{
+        uint16_t port;
+        io_engine engine;
+        wait_strategy wait;
+        long long connections;
+        long long messages;
+        long long size;
+        long long bytes;
+        // Socket tuning of server and clients (--profile)
+        const char* profile;
+        socket_options tuning;
+};
+
+// Connected, length-prefixed client
+static int open_client(client_socket& client, uint16_t port, const socket_options& tuning){
+        client.c_options = tuning;
+        if ( client.c_create() < 0 || client.c_connect("127.0.0.1", port) < 0 ) {
+                return -1;
+        }
+        return client.c_negotiate_framing();
+}
+
+static int bench_accept(const bench_options& options){
+        bench_server server;
+        if ( server.start(options.port, options.engine, options.wait, options.tuning, false) < 0 ) {
+                return -1;
+        }
+        long long threads = options.connections > 0 ? options.connections : 4;
+        long long total = options.messages > 0 ? options.messages : 10000;
+        std::atomic<uint64_t> failed{0};
+
+        uint64_t start = bench_now_ns();
+        std::vector<std::thread> clients;
+        for (long long t = 0; t < threads; t++) {
+                clients.emplace_back([&, t] {
+                        for (long long i = t; i < total; i += threads) {
+                                client_socket client;
+                                client.c_options = options.tuning;
+                                if ( client.c_create() < 0 || client.c_connect("127.0.0.1", options.port) < 0 ) {
+                                        failed++;
+                                }
+                                client.c_close();
+                        }
+                });
+        }
+        for (std::thread& client : clients) {
+                client.join();
+        }
+        uint64_t target = (uint64_t) total - failed.load();
+        uint64_t deadline = bench_now_ns() + 10000000000ULL;
+        while (server.accepted.load() < target && bench_now_ns() < deadline) {
+                std::this_thread::yield();
+        }
+        double seconds = (double) (bench_now_ns() - start) / 1e9;
+        server.finish();
+
+        json_line()
+                .add("benchmark", "accept")
+                .add("engine", server.engine_name())
+                .add("wait", server.wait_name())
+                .add("profile", options.profile)
+                .add("threads", (uint64_t) threads)
+                .add("connections", (uint64_t) total)
+                .add("accepted", server.accepted.load())
+                .add("failed", failed.load())
+                .add("seconds", seconds)
+                .add("accepts_per_s", (double) server.accepted.load() / seconds)
+                .print();
+        return 0;
+}
+
+static int bench_echo(const bench_options& options){
+        bench_server server;
+        if ( server.start(options.port, options.engine, options.wait, options.tuning, true) < 0 ) {
+                return -1;
+        }
+        long long total = options.messages > 0 ? options.messages : 100000;
+        size_t size = options.size > 0 ? (size_t) options.size : 64;
+
+        client_socket client;
+        if ( open_client(client, options.port, options.tuning) < 0 ) {
+                server.finish();
+                return -1;
+        }
+        std::string payload(size, 'e');
+        recv_buffer rx;
+        rx.framing = FRAMING_LENGTH_PREFIXED;
+        std::vector<uint64_t> samples;
+        samples.reserve((size_t) total);
+
+        uint64_t start = 0;
+        uint64_t errors = 0;
+        for (long long i = 0; i < total + BENCH_WARMUP; i++) {
+                if (i == BENCH_WARMUP) {
+                        start = bench_now_ns();
+                }
+                uint64_t sent = bench_now_ns();
+                if ( client.c_write_len(payload.data(), payload.size()) < 0 ) {
+                        errors++;
+                        break;
+                }
+                frame_view reply;
+                bool received = false;
+                while ( !received ) {
+                        if ( rx.next_frame(reply) ) {
+                                received = true;
+                        } else if ( rx.fill(client.c_sockfd) <= 0 ) {
+                                break;
+                        }
+                }
+                if (!received) {
+                        errors++;
+                        break;
+                }
+                if (i >= BENCH_WARMUP) {
+                        samples.push_back(bench_now_ns() - sent);
+                }
+        }
+        double seconds = (double) (bench_now_ns() - start) / 1e9;
+        client.c_close();
+        server.finish();
+
+        uint64_t round_trips = samples.size();
+        json_line()
+                .add("benchmark", "echo")
+                .add("engine", server.engine_name())
+                .add("wait", server.wait_name())
+                .add("profile", options.profile)
+                .add("size", (uint64_t) size)
+                .add("round_trips", round_trips)
+                .add("errors", errors)
+                .add("round_trips_per_s", (double) round_trips / seconds)
+                .add("rtt", summarize(samples))
+                .print();
+        return 0;
+}
+
+static int bench_throughput(const bench_options& options){
+        bench_server server;
+        if ( server.start(options.port, options.engine, options.wait, options.tuning, false) < 0 ) {
+                return -1;
+        }
+        long long connections = options.connections > 0 ? options.connections : 8;
+        long long per_connection = (options.messages > 0 ? options.messages : 1000000) / connections;
+        size_t size = options.size > 0 ? (size_t) options.size : 64;
+        std::atomic<uint64_t> errors{0};
+
+        // Connect everyone first so the timed part is only sending
+        std::vector<client_socket> clients((size_t) connections);
+        for (client_socket& client : clients) {
+                if ( open_client(client, options.port, options.tuning) < 0 ) {
+                        server.finish();
+                        return -1;
+                }
+        }
+
+        std::string payload(size, 't');
+        uint64_t start = bench_now_ns();
+        std::vector<std::thread> senders;
+        for (client_socket& client : clients) {
+                senders.emplace_back([&] {
+                        std::vector<frame_view> batch(BENCH_BATCH, frame_view{payload.data(), payload.size()});
+                        for (long long sent = 0; sent < per_connection; sent += BENCH_BATCH) {
+                                size_t count = (size_t) std::min<long long>(BENCH_BATCH, per_connection - sent);
+                                if ( client.c_write_batch(batch.data(), count) < 0 ) {
+                                        errors++;
+                                        return;
+                                }
+                        }
+                });
+        }
+        for (std::thread& sender : senders) {
+                sender.join();
+        }
+        uint64_t total = (uint64_t) (per_connection * connections);
+        bool complete = server.wait_messages(total, 30);
+        double seconds = (double) (bench_now_ns() - start) / 1e9;
+        for (client_socket& client : clients) {
+                client.c_close();
+        }
+        server.finish();
+
+        uint64_t received = server.messages.load();
+        json_line()
+                .add("benchmark", "throughput")
+                .add("engine", server.engine_name())
+                .add("wait", server.wait_name())
+                .add("profile", options.profile)
+                .add("connections", (uint64_t) connections)
+                .add("size", (uint64_t) size)
+                .add("messages", received)
+                .add("errors", errors.load() + (complete ? 0 : 1))
+                .add("seconds", seconds)
+                .add("messages_per_s", (double) received / seconds)
+                .add("mb_per_s", (double) received * (double) size / seconds / 1e6)
+                .print();
+        return 0;
+}
+
+static int bench_bandwidth(const bench_options& options){
+        bench_server server;
+        if ( server.start(options.port, options.engine, options.wait, options.tuning, false) < 0 ) {
+                return -1;
+        }
+        long long connections = options.connections > 0 ? options.connections : 1;
+        // Chunks stay under the receiver's 1 MiB message limit
+        size_t chunk = options.size > 0 ? (size_t) options.size : 256 * 1024;
+        long long total_bytes = options.bytes > 0 ? options.bytes : 1LL << 30;
+        long long chunks_per_connection = std::max<long long>(1, total_bytes / connections / (long long) chunk);
+        std::atomic<uint64_t> errors{0};
+
+        std::vector<client_socket> clients((size_t) connections);
+        for (client_socket& client : clients) {
+                if ( open_client(client, options.port, options.tuning) < 0 ) {
+                        server.finish();
+                        return -1;
+                }
+        }
+
+        std::string payload(chunk, 'b');
+        uint64_t start = bench_now_ns();
+        std::vector<std::thread> senders;
+        for (client_socket& client : clients) {
+                senders.emplace_back([&] {
+                        for (long long i = 0; i < chunks_per_connection; i++) {
+                                if ( client.c_write_len(payload.data(), payload.size()) < 0 ) {
+                                        errors++;
+                                        return;
+                                }
+                        }
+                });
+        }
+        for (std::thread& sender : senders) {
+                sender.join();
+        }
+        uint64_t total = (uint64_t) (chunks_per_connection * connections);
+        bool complete = server.wait_messages(total, 60);
+        double seconds = (double) (bench_now_ns() - start) / 1e9;
+        for (client_socket& client : clients) {
+                client.c_close();
+        }
+        server.finish();
+
+        double bytes = (double) server.messages.load() * (double) chunk;
+        json_line()
+                .add("benchmark", "bandwidth")
+                .add("engine", server.engine_name())
+                .add("wait", server.wait_name())
+                .add("profile", options.profile)
+                .add("connections", (uint64_t) connections)
+                .add("chunk", (uint64_t) chunk)
+                .add("bytes", (uint64_t) bytes)
+                .add("errors", errors.load() + (complete ? 0 : 1))
+                .add("seconds", seconds)
+                .add("mb_per_s", bytes / seconds / 1e6)
+                .add("gbit_per_s", bytes * 8 / seconds / 1e9)
+                .print();
+        return 0;
+}
+
+static std::atomic<bool> interrupted{false};
+
+static void on_signal(int){
+        interrupted = true;
+}
+
+static int serve(const bench_options& options){
+        bench_server server;
+        if ( server.start(options.port, options.engine, options.wait, options.tuning, true) < 0 ) {
+                return -1;
+        }
+        signal(SIGINT, on_signal);
+        signal(SIGTERM, on_signal);
+        fprintf(stderr, "rsocket_bench: echo server on port %u (%s, %s wait, %s profile), Ctrl-C to stop\n", options.port,
+                server.engine_name(), server.wait_name(), options.profile);
+        while ( !interrupted ) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        server.finish();
+
+        json_line()
+                .add("server", "echo")
+                .add("engine", server.engine_name())
+                .add("wait", server.wait_name())
+                .add("profile", options.profile)
+                .add("accepted", server.accepted.load())
+                .add("messages", server.messages.load())
+                .add("dropped", server.dropped.load())
+                .print();
+        fputs(metrics_prometheus().c_str(), stderr);
+        return 0;
+}
+
+int main(int argc, char** argv){
+        if ( bench_flag(argc, argv, "--help") || bench_flag(argc, argv, "-h") ) {
+                usage();
+                return 0;
+        }
+        // Errors still show, per-connection info would skew the numbers
+        log_set_level(LOG_LEVEL_ERROR);
+
+        bench_options options;
+        options.port = (uint16_t) bench_arg_int(argc, argv, "--port", BENCH_DEFAULT_PORT);
+        std::string engine = bench_arg(argc, argv, "--engine", "epoll");
+        options.engine = (engine == "uring") ? ENGINE_URING : ENGINE_EPOLL;
+        std::string wait = bench_arg(argc, argv, "--wait", "timed");
+        options.wait = (wait == "blocking") ? WAIT_BLOCKING : (wait == "busy") ? WAIT_BUSY_POLL
+                       : (wait == "adaptive") ? WAIT_ADAPTIVE : WAIT_TIMED;
+        std::string profile = bench_arg(argc, argv, "--profile", "default");
+        options.profile = (profile == "latency") ? "latency" : (profile == "throughput") ? "throughput" : "default";
+        options.tuning = (profile == "latency") ? socket_options::low_latency()
+                         : (profile == "throughput") ? socket_options::high_throughput() : socket_options();
+        options.connections = bench_arg_int(argc, argv, "--connections", 0);
+        options.messages = bench_arg_int(argc, argv, "--messages", 0);
+        options.size = bench_arg_int(argc, argv, "--size", 0);
+        options.bytes = bench_arg_int(argc, argv, "--bytes", 0);
+
+        if ( bench_flag(argc, argv, "--serve") ) {
+                return serve(options) < 0 ? 1 : 0;
+        }
+
+        std::string scenario = bench_arg(argc, argv, "--scenario", "all");
+        int (*benchmarks[])(const bench_options&) = {bench_accept, bench_echo, bench_throughput, bench_bandwidth};
+        const char* names[] = {"accept", "echo", "throughput", "bandwidth"};
+        bool ran = false;
+        for (int i = 0; i < 4; i++) {
+                if (scenario != "all" && scenario != names[i]) {
+                        continue;
+                }
+                ran = true;
+                if ( benchmarks[i](options) < 0 ) {
+                        fprintf(stderr, "rsocket_bench: %s failed (errno %d)\n", names[i], errno);
+                        return 1;
+                }
+                // Each benchmark listens again, use a fresh port so TIME_WAIT doesn't interfere
+                options.port++;
+        }
+        if (!ran) {
+                usage();
+                return 1;
+        }
+        return 0;
+}
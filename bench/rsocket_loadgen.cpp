@@ -0,0 +1,180 @@
+//--------------------------
+// rsocket_loadgen
+//--------------------------
+// Description:
+// Load generator for echo servers (e.g., rsocket_bench --serve): N length-prefixed connections
+// send timestamped messages, open loop at a fixed rate or closed loop with a window of
+// outstanding requests, and report throughput and round-trip latency as a JSON line
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+// Default settings
+//-----------------------------
+#define LOADGEN_DEFAULT_PORT 9950
+// Time (ms) to wait for outstanding replies after the run
+#define LOADGEN_DRAIN_TIMEOUT 1000
+//-----------------------------
+
+// Includes
+//-----------------------------
+#include <atomic>
+#include <thread>
+#include <poll.h>
+
+#include "client_socket.h"
+#include "logger.h"
+#include "recv_buffer.h"
+
+#include "bench_util.h"
+//-----------------------------
+
+static void usage(){
+        fprintf(stderr,
+                "usage: rsocket_loadgen [--host ADDR] [--port N] [--connections N] [--duration SECONDS]\n"
+                "                       [--rate MSGS_PER_S_PER_CONNECTION (0 = as fast as the window allows)]\n"
+                "                       [--window OUTSTANDING] [--size BYTES (>= 8)]\n");
+}
+
+struct loadgen_options
+{
+        std::string host;
+        uint16_t port;
+        long long connections;
+        double duration;
+        double rate;
+        long long window;
+        size_t size;
+};
+
+struct loadgen_result
+{
+        uint64_t sent = 0;
+        uint64_t received = 0;
+        uint64_t errors = 0;
+        std::vector<uint64_t> samples;
+};
+
+// One connection: keep up to window requests in flight, paced to rate if set
+static void run_connection(const loadgen_options& options, uint64_t end, loadgen_result& result){
+        client_socket client;
+        if ( client.c_create() < 0 || client.c_connect(options.host.c_str(), options.port) < 0 || client.c_negotiate_framing() < 0 ) {
+                result.errors++;
+                return;
+        }
+
+        recv_buffer rx;
+        rx.framing = FRAMING_LENGTH_PREFIXED;
+        std::string payload(options.size, 'l');
+        uint64_t interval = options.rate > 0 ? (uint64_t) (1e9 / options.rate) : 0;
+        uint64_t next_send = bench_now_ns();
+        uint64_t drain_end = end + (uint64_t) LOADGEN_DRAIN_TIMEOUT * 1000000;
+        long long outstanding = 0;
+
+        while (true) {
+                uint64_t now = bench_now_ns();
+                bool sending = now < end;
+                if (!sending && (outstanding == 0 || now >= drain_end)) {
+                        break;
+                }
+
+                // The send time travels in the payload and comes back with the echo
+                while ( sending && outstanding < options.window && (interval == 0 || now >= next_send) ) {
+                        std::memcpy(&payload[0], &now, sizeof(now));
+                        if ( client.c_write_len(payload.data(), payload.size()) < 0 ) {
+                                result.errors++;
+                                return;
+                        }
+                        result.sent++;
+                        outstanding++;
+                        next_send += interval;
+                        now = bench_now_ns();
+                }
+
+                // Sleep in 1 ms steps (doubling as the pacing timer), don't when a paced send is due sooner
+                int wait = 1;
+                if ( sending && interval != 0 && outstanding < options.window && next_send < now + 1000000 ) {
+                        wait = 0;
+                }
+                struct pollfd pfd = {client.c_sockfd, POLLIN, 0};
+                int ready = poll(&pfd, 1, wait);
+                if (ready <= 0) {
+                        continue;
+                }
+                if ( rx.fill(client.c_sockfd) <= 0 ) {
+                        result.errors++;
+                        return;
+                }
+                frame_view reply;
+                uint64_t received = bench_now_ns();
+                while ( rx.next_frame(reply) ) {
+                        uint64_t stamp;
+                        if (reply.size >= sizeof(stamp)) {
+                                std::memcpy(&stamp, reply.data, sizeof(stamp));
+                                result.samples.push_back(received - stamp);
+                        }
+                        result.received++;
+                        outstanding--;
+                }
+        }
+        client.c_close();
+}
+
+int main(int argc, char** argv){
+        if ( bench_flag(argc, argv, "--help") || bench_flag(argc, argv, "-h") ) {
+                usage();
+                return 0;
+        }
+        log_set_level(LOG_LEVEL_ERROR);
+
+        loadgen_options options;
+        options.host = bench_arg(argc, argv, "--host", "127.0.0.1");
+        options.port = (uint16_t) bench_arg_int(argc, argv, "--port", LOADGEN_DEFAULT_PORT);
+        options.connections = std::max<long long>(1, bench_arg_int(argc, argv, "--connections", 8));
+        options.duration = std::strtod(bench_arg(argc, argv, "--duration", "10"), nullptr);
+        options.rate = std::strtod(bench_arg(argc, argv, "--rate", "0"), nullptr);
+        options.window = std::max<long long>(1, bench_arg_int(argc, argv, "--window", 16));
+        options.size = (size_t) std::max<long long>(8, bench_arg_int(argc, argv, "--size", 64));
+
+        std::vector<loadgen_result> results((size_t) options.connections);
+        uint64_t start = bench_now_ns();
+        uint64_t end = start + (uint64_t) (options.duration * 1e9);
+        std::vector<std::thread> threads;
+        for (loadgen_result& result : results) {
+                threads.emplace_back(run_connection, std::cref(options), end, std::ref(result));
+        }
+        for (std::thread& thread : threads) {
+                thread.join();
+        }
+        double seconds = (double) (bench_now_ns() - start) / 1e9;
+
+        loadgen_result total;
+        for (loadgen_result& result : results) {
+                total.sent += result.sent;
+                total.received += result.received;
+                total.errors += result.errors;
+                total.samples.insert(total.samples.end(), result.samples.begin(), result.samples.end());
+        }
+
+        json_line()
+                .add("tool", "rsocket_loadgen")
+                .add("host", options.host.c_str())
+                .add("port", (uint64_t) options.port)
+                .add("connections", (uint64_t) options.connections)
+                .add("size", (uint64_t) options.size)
+                .add("window", (uint64_t) options.window)
+                .add("target_rate", options.rate * (double) options.connections)
+                .add("seconds", seconds)
+                .add("sent", total.sent)
+                .add("received", total.received)
+                .add("errors", total.errors)
+                .add("messages_per_s", (double) total.received / seconds)
+                .add("rtt", summarize(total.samples))
+                .print();
+        return total.errors > 0 ? 1 : 0;
+}
@@ -0,0 +1,137 @@
+//--------------------------
+// Buffer pool module
+//--------------------------
+// Description:
+// Size-classed buffer allocator shared by all connections, buffers are leased on demand
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#include "buffer_pool.h"
+
+//-----------------------------
+// Class: buffer_pool
+//-----------------------------
+
+buffer_pool::buffer_pool(){
+}
+
+buffer_pool::~buffer_pool(){
+        for (size_t i = 0; i < sizeof(classes) / sizeof(classes[0]); i++) {
+                size_class& sc = classes[i];
+                if ( sc.slabs.empty() ) {
+                        for (char* buffer : sc.free) {
+                                free(buffer);
+                        }
+                } else {
+                        for (char* slab : sc.slabs) {
+                                free(slab);
+                        }
+                }
+        }
+}
+
+buffer_pool& buffer_pool::shared(){
+        // Never destroyed, buffers may still be released by static objects during exit
+        static buffer_pool* instance = new buffer_pool();
+        return *instance;
+}
+
+int buffer_pool::class_index(size_t size){
+        size_t rounded = (size_t) 1 << BUFFER_POOL_MIN_SHIFT;
+        int index = 0;
+        while (rounded < size) {
+                rounded <<= 1;
+                index++;
+                if (index > BUFFER_POOL_MAX_SHIFT - BUFFER_POOL_MIN_SHIFT) {
+                        return -1;
+                }
+        }
+        return index;
+}
+
+size_t buffer_pool::round_up(size_t size){
+        int index = class_index(size);
+        if (index < 0) {
+                return size;
+        }
+        return (size_t) 1 << (index + BUFFER_POOL_MIN_SHIFT);
+}
+
+char* buffer_pool::acquire(size_t size, size_t& capacity){
+        int index = class_index(size);
+        if (index < 0) {
+                capacity = size;
+                return (char*) malloc(size);
+        }
+        size_t class_size = (size_t) 1 << (index + BUFFER_POOL_MIN_SHIFT);
+        size_class& sc = classes[index];
+        capacity = class_size;
+
+        std::lock_guard<std::mutex> guard(sc.lock);
+        if ( sc.free.empty() ) {
+                if (class_size < BUFFER_POOL_SLAB_SIZE) {
+                        // One allocation provides a whole slab of buffers
+                        char* slab = (char*) malloc(BUFFER_POOL_SLAB_SIZE);
+                        if (slab == nullptr) {
+                                return nullptr;
+                        }
+                        sc.slabs.push_back(slab);
+                        for (size_t offset = BUFFER_POOL_SLAB_SIZE; offset > 0; offset -= class_size) {
+                                sc.free.push_back(slab + offset - class_size);
+                        }
+                } else {
+                        char* buffer = (char*) malloc(class_size);
+                        if (buffer == nullptr) {
+                                return nullptr;
+                        }
+                        sc.free.push_back(buffer);
+                }
+        }
+        char* buffer = sc.free.back();
+        sc.free.pop_back();
+        sc.leased++;
+        return buffer;
+}
+
+void buffer_pool::release(char* buffer, size_t capacity){
+        if (buffer == nullptr) {
+                return;
+        }
+        int index = class_index(capacity);
+        if (index < 0) {
+                free(buffer);
+                return;
+        }
+        size_class& sc = classes[index];
+        std::lock_guard<std::mutex> guard(sc.lock);
+        sc.leased--;
+        if ( sc.slabs.empty() && (sc.free.size() + 1) * capacity > BUFFER_POOL_CACHE_LIMIT ) {
+                free(buffer);
+                return;
+        }
+        sc.free.push_back(buffer);
+}
+
+size_t buffer_pool::leased_bytes(){
+        size_t total = 0;
+        for (size_t i = 0; i < sizeof(classes) / sizeof(classes[0]); i++) {
+                std::lock_guard<std::mutex> guard(classes[i].lock);
+                total += classes[i].leased << (i + BUFFER_POOL_MIN_SHIFT);
+        }
+        return total;
+}
+
+size_t buffer_pool::cached_bytes(){
+        size_t total = 0;
+        for (size_t i = 0; i < sizeof(classes) / sizeof(classes[0]); i++) {
+                std::lock_guard<std::mutex> guard(classes[i].lock);
+                total += classes[i].free.size() << (i + BUFFER_POOL_MIN_SHIFT);
+        }
+        return total;
+}
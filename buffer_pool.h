@@ -0,0 +1,82 @@
+//--------------------------
+// Buffer pool module header
+//--------------------------
+// Description:
+// Size-classed buffer allocator shared by all connections, buffers are leased on demand
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#ifndef _buffer_pool_H_INCLUDED
+#define _buffer_pool_H_INCLUDED
+
+// Default settings
+//-----------------------------
+// Smallest size class (2^9 = 512 bytes), every class is a power of two
+#define BUFFER_POOL_MIN_SHIFT 9
+// Largest pooled size class (2^24 = 16 MB), bigger requests go straight to the allocator
+#define BUFFER_POOL_MAX_SHIFT 24
+// Classes up to this size are carved out of slabs of this size
+#define BUFFER_POOL_SLAB_SIZE (64 * 1024)
+// Free buffers kept per class above the slab size, the rest go back to the system
+#define BUFFER_POOL_CACHE_LIMIT (4 * 1024 * 1024)
+//-----------------------------
+
+// Includes
+//-----------------------------
+#include <cstddef>
+#include <cstdlib>
+#include <mutex>
+#include <vector>
+//-----------------------------
+
+// Thread-safe: each size class has its own lock, so workers only contend when they lease the same size
+// Small classes never return slab memory to the system, it is reused by later leases instead
+class buffer_pool
+{
+    private:
+        struct size_class
+        {
+                std::mutex lock;
+                std::vector<char*> free;
+                // Slabs this class carved its buffers from (small classes only)
+                std::vector<char*> slabs;
+                size_t leased = 0;
+        };
+
+        size_class classes[BUFFER_POOL_MAX_SHIFT - BUFFER_POOL_MIN_SHIFT + 1];
+
+        // Index into classes for a request of size bytes, -1 if it is too large to pool
+        static int class_index(size_t size);
+
+    public:
+        buffer_pool();
+        ~buffer_pool();
+
+        buffer_pool(const buffer_pool&) = delete;
+        buffer_pool& operator=(const buffer_pool&) = delete;
+
+        // Lease a buffer of at least size bytes (contents undefined), capacity is set to its real size
+        // Returns nullptr if memory is exhausted
+        char* acquire(size_t size, size_t& capacity);
+
+        // Hand a buffer back, capacity must be the value acquire() returned
+        void release(char* buffer, size_t capacity);
+
+        // Size actually leased for a request of size bytes
+        static size_t round_up(size_t size);
+
+        // Bytes currently leased out / held in free lists
+        size_t leased_bytes();
+        size_t cached_bytes();
+
+        // Pool shared by recv_buffer, client_socket and server_socket
+        static buffer_pool& shared();
+};
+
+#endif // buffer_pool.h
@@ -0,0 +1,295 @@
+//--------------------------
+// Client pool module
+//--------------------------
+// Description:
+// Keeps warm client_socket connections to a set of endpoints and leases them out
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#include "client_pool.h"
+
+//-----------------------------
+// Class: client_lease
+//-----------------------------
+
+client_lease::client_lease(){
+}
+
+client_lease::client_lease(client_pool* p, int s) : pool(p), slot(s) {
+}
+
+client_lease::~client_lease(){
+        release();
+}
+
+client_lease::client_lease(client_lease&& other) noexcept : pool(other.pool), slot(other.slot) {
+        other.pool = nullptr;
+        other.slot = -1;
+}
+
+client_lease& client_lease::operator=(client_lease&& other) noexcept {
+        if (this != &other) {
+                release();
+                pool = other.pool;
+                slot = other.slot;
+                other.pool = nullptr;
+                other.slot = -1;
+        }
+        return *this;
+}
+
+bool client_lease::valid(){
+        return pool != nullptr;
+}
+
+// Sockets are only replaced while nobody holds a lease on them, so no lock is needed here
+client_socket& client_lease::socket(){
+        return *pool->connections[slot].socket;
+}
+
+client_socket* client_lease::operator->(){
+        return pool->connections[slot].socket.get();
+}
+
+int client_lease::endpoint(){
+        return pool->connections[slot].endpoint;
+}
+
+void client_lease::release(){
+        if (pool != nullptr) {
+                pool->give_back(slot, true);
+                pool = nullptr;
+                slot = -1;
+        }
+}
+
+void client_lease::discard(){
+        if (pool != nullptr) {
+                pool->give_back(slot, false);
+                pool = nullptr;
+                slot = -1;
+        }
+}
+
+//-----------------------------
+// Class: client_pool
+//-----------------------------
+
+client_pool::client_pool() : client_pool(DEFAULT_POOL_CONNECTIONS) {
+}
+
+client_pool::client_pool(int c_p_e) : running(false) {
+        connections_per_endpoint = (c_p_e > 0) ? c_p_e : 1;
+}
+
+client_pool::~client_pool(){
+        stop();
+}
+
+void client_pool::add_endpoint(const std::string& host, uint16_t port){
+        std::lock_guard<std::mutex> guard(lock);
+        pool_endpoint endpoint;
+        endpoint.host = host;
+        endpoint.port = port;
+        endpoints.push_back(endpoint);
+}
+
+int client_pool::start(){
+        std::lock_guard<std::mutex> guard(lock);
+        if ( endpoints.empty() ) {
+                errno = EINVAL;
+                return -1;
+        }
+        connections.clear();
+        for (size_t e = 0; e < endpoints.size(); e++) {
+                for (int i = 0; i < connections_per_endpoint; i++) {
+                        pooled_connection connection;
+                        connection.socket.reset(new client_socket());
+                        connection.endpoint = (int) e;
+                        connections.push_back(std::move(connection));
+                }
+        }
+        running = true;
+        maintenance = std::thread(&client_pool::maintain, this);
+        return 0;
+}
+
+void client_pool::stop(){
+        if ( !running.exchange(false) ) {
+                return;
+        }
+        maintenance.join();
+
+        std::lock_guard<std::mutex> guard(lock);
+        // Leased connections are closed when they are handed back
+        for (size_t slot = 0; slot < connections.size(); slot++) {
+                if ( !connections[slot].leased ) {
+                        drop((int) slot);
+                }
+        }
+        idle_ready.notify_all();
+}
+
+// Maintenance thread: reconnects dropped connections (in parallel, through connector) and checks idle ones
+void client_pool::maintain(){
+        connector dialer;
+        dialer.c_domain = c_domain;
+        dialer.c_type = c_type;
+        if ( dialer.init() < 0 ) {
+                RSOCKET_LOG_ERROR("Connection pool could not start its connector");
+                return;
+        }
+
+        struct dial
+        {
+                int slot;
+                std::string host;
+                uint16_t port;
+        };
+        std::vector<dial> dials;
+
+        while (running) {
+                dials.clear();
+                {
+                        std::lock_guard<std::mutex> guard(lock);
+                        auto now = std::chrono::steady_clock::now();
+                        for (size_t slot = 0; slot < connections.size(); slot++) {
+                                pooled_connection& connection = connections[slot];
+                                if (connection.connected || connection.connecting || connection.leased) {
+                                        continue;
+                                }
+                                pool_endpoint& endpoint = endpoints[connection.endpoint];
+                                if (now < endpoint.retry_at) {
+                                        continue;
+                                }
+                                connection.connecting = true;
+                                dials.push_back(dial{(int) slot, endpoint.host, endpoint.port});
+                        }
+                }
+                for (auto& d : dials) {
+                        int slot = d.slot;
+                        dialer.connect_to(d.host.c_str(), d.port, connect_timeout, [this, slot](int fd, int error) {
+                                connected(slot, fd, error);
+                        });
+                }
+
+                check_idle();
+                dialer.poll(DEFAULT_POOL_MAINTENANCE_INTERVAL);
+        }
+}
+
+// A peer that closed an idle connection shows up as a readable EOF, drop those before they are leased
+void client_pool::check_idle(){
+        std::lock_guard<std::mutex> guard(lock);
+        for (size_t slot = 0; slot < connections.size(); slot++) {
+                pooled_connection& connection = connections[slot];
+                if (!connection.connected || connection.leased) {
+                        continue;
+                }
+                char byte;
+                ssize_t n = recv(connection.socket->c_sockfd, &byte, 1, MSG_PEEK | MSG_DONTWAIT);
+                if ( n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK) ) {
+                        RSOCKET_LOG_DEBUG("Pooled connection to %s closed while idle", endpoints[connection.endpoint].host.c_str());
+                        drop((int) slot);
+                }
+        }
+}
+
+void client_pool::connected(int slot, int fd, int error){
+        std::lock_guard<std::mutex> guard(lock);
+        pooled_connection& connection = connections[slot];
+        connection.connecting = false;
+        if (fd < 0) {
+                pool_endpoint& endpoint = endpoints[connection.endpoint];
+                RSOCKET_LOG_WARN("Pool connect to %s:%u failed (errno %d)", endpoint.host.c_str(), (unsigned) endpoint.port, error);
+                endpoint.retry_at = std::chrono::steady_clock::now() + std::chrono::milliseconds(DEFAULT_POOL_RETRY_DELAY);
+                return;
+        }
+        if ( !running || connection.socket->c_adopt(fd) < 0 ) {
+                close(fd);
+                return;
+        }
+        connection.connected = true;
+        idle_ready.notify_one();
+}
+
+void client_pool::drop(int slot){
+        pooled_connection& connection = connections[slot];
+        if (connection.connected) {
+                connection.socket->c_close();
+                connection.connected = false;
+        }
+}
+
+void client_pool::give_back(int slot, bool healthy){
+        std::lock_guard<std::mutex> guard(lock);
+        pooled_connection& connection = connections[slot];
+        connection.leased = false;
+        endpoints[connection.endpoint].outstanding--;
+        if (!healthy || !running) {
+                drop(slot);
+                return;
+        }
+        idle_ready.notify_one();
+}
+
+client_lease client_pool::acquire(int timeout){
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+        std::unique_lock<std::mutex> guard(lock);
+        while (running) {
+                // Idle connection on the endpoint with the fewest outstanding leases, ties rotate
+                int best = -1;
+                unsigned best_outstanding = 0;
+                size_t best_rank = 0;
+                for (size_t slot = 0; slot < connections.size(); slot++) {
+                        pooled_connection& connection = connections[slot];
+                        if (!connection.connected || connection.leased) {
+                                continue;
+                        }
+                        unsigned load = endpoints[connection.endpoint].outstanding;
+                        size_t rank = ((size_t) connection.endpoint + endpoints.size() - next_endpoint % endpoints.size()) % endpoints.size();
+                        if ( best < 0 || load < best_outstanding || (load == best_outstanding && rank < best_rank) ) {
+                                best = (int) slot;
+                                best_outstanding = load;
+                                best_rank = rank;
+                        }
+                }
+                if (best >= 0) {
+                        pooled_connection& connection = connections[best];
+                        connection.leased = true;
+                        endpoints[connection.endpoint].outstanding++;
+                        next_endpoint = (unsigned) connection.endpoint + 1;
+                        return client_lease(this, best);
+                }
+
+                if (timeout < 0) {
+                        idle_ready.wait(guard);
+                } else if ( idle_ready.wait_until(guard, deadline) == std::cv_status::timeout ) {
+                        break;
+                }
+        }
+        errno = running ? ETIMEDOUT : ESHUTDOWN;
+        return client_lease();
+}
+
+size_t client_pool::connected_count(){
+        std::lock_guard<std::mutex> guard(lock);
+        size_t count = 0;
+        for (auto& connection : connections) {
+                if (connection.connected) {
+                        count++;
+                }
+        }
+        return count;
+}
+
+unsigned client_pool::outstanding(int endpoint){
+        std::lock_guard<std::mutex> guard(lock);
+        return endpoints[endpoint].outstanding;
+}
@@ -0,0 +1,159 @@
+//--------------------------
+// Client pool module header
+//--------------------------
+// Description:
+// Keeps warm client_socket connections to a set of endpoints and leases them out
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#ifndef _client_pool_H_INCLUDED
+#define _client_pool_H_INCLUDED
+
+// Default settings
+//-----------------------------
+// Connections kept open to every endpoint
+#define DEFAULT_POOL_CONNECTIONS 4
+// How often (ms) the maintenance thread reconnects and checks idle connections
+#define DEFAULT_POOL_MAINTENANCE_INTERVAL 250
+// Wait (ms) before retrying an endpoint whose connect failed
+#define DEFAULT_POOL_RETRY_DELAY 1000
+//-----------------------------
+
+// Includes
+//-----------------------------
+// Standard libraries
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "client_socket.h"
+#include "connector.h"
+#include "logger.h"
+//-----------------------------
+
+class client_pool;
+
+// Exclusive use of one pooled connection, handed back when destroyed
+class client_lease
+{
+    private:
+        client_pool* pool = nullptr;
+        int slot = -1;
+
+    public:
+        client_lease();
+        client_lease(client_pool* p, int s);
+        ~client_lease();
+
+        client_lease(client_lease&& other) noexcept;
+        client_lease& operator=(client_lease&& other) noexcept;
+        client_lease(const client_lease&) = delete;
+        client_lease& operator=(const client_lease&) = delete;
+
+        // False if acquire() timed out
+        bool valid();
+
+        client_socket& socket();
+        client_socket* operator->();
+
+        // Endpoint (index into client_pool::endpoints) this connection goes to
+        int endpoint();
+
+        // Hand the connection back for reuse
+        void release();
+
+        // The connection is broken (error / EOF), close it and let the pool reconnect in the background
+        void discard();
+};
+
+// Thread-safe, acquire() may be called from any thread
+// Leases go to the endpoint with the fewest outstanding leases that has an idle connection
+class client_pool
+{
+    private:
+        struct pool_endpoint
+        {
+                std::string host;
+                uint16_t port;
+                // Leases currently held on this endpoint
+                unsigned outstanding = 0;
+                std::chrono::steady_clock::time_point retry_at;
+        };
+
+        struct pooled_connection
+        {
+                std::unique_ptr<client_socket> socket;
+                int endpoint;
+                bool connected = false;
+                bool connecting = false;
+                bool leased = false;
+        };
+
+        std::mutex lock;
+        std::condition_variable idle_ready;
+        std::vector<pool_endpoint> endpoints;
+        std::vector<pooled_connection> connections;
+        // Ties go to the first endpoint after the one picked last, so they don't always pick the first one
+        unsigned next_endpoint = 0;
+
+        std::thread maintenance;
+        std::atomic<bool> running;
+
+        void maintain();
+        void check_idle();
+        void connected(int slot, int fd, int error);
+        void drop(int slot);
+
+        friend class client_lease;
+        void give_back(int slot, bool healthy);
+
+    public:
+        // Connections opened to each endpoint
+        int connections_per_endpoint;
+        // Time (ms) allowed for each background connect
+        int connect_timeout = DEFAULT_CONNECT_TIMEOUT;
+        // Address family / type used for connects
+        int c_domain = AF_UNSPEC;
+        int c_type = SOCK_STREAM;
+
+        client_pool();
+        explicit client_pool(int c_p_e);
+        //--------------------connections_per_endpoint
+        ~client_pool();
+
+        client_pool(const client_pool&) = delete;
+        client_pool& operator=(const client_pool&) = delete;
+
+        // Add before start()
+        void add_endpoint(const std::string& host, uint16_t port);
+
+        // Start the maintenance thread, which opens and keeps the connections open
+        // Returns 0, or -1 if there are no endpoints
+        int start();
+
+        // Close every connection, outstanding leases become invalid when they are handed back
+        void stop();
+
+        // Lease an idle connection, waiting up to timeout ms (-1 = forever) for one
+        // Check valid() on the result
+        client_lease acquire(int timeout);
+
+        // Open connections (leased or idle)
+        size_t connected_count();
+
+        // Leases currently held on an endpoint
+        unsigned outstanding(int endpoint);
+};
+
+#endif // client_pool.h
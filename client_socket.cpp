@@ -8,7 +8,7 @@
 // Email: lmbernar@uark.edu
 //
 // Created July 20th, 2018
-// Modified: November 7th, 2018
+// Modified: October 17th, 2026
 // Version 0.5
 //--------------------------
 
@@ -29,12 +29,9 @@ client_socket::client_socket(){
         // Use Internet Protocol (IP)
         c_protocol = DEFAULT_PROTOCOL;
 
-        // Create receive buffer
-        socket_read_buffer = new char[DEFAULT_SOCKET_BUFFER_SIZE];
+        // Receive buffer is leased from the buffer pool by the first c_read()
+        socket_read_buffer = nullptr;
         socket_read_buffer_size = DEFAULT_SOCKET_BUFFER_SIZE;
-        for (int i=0; i<socket_read_buffer_size; i++) {
-                socket_read_buffer[i] = 0;
-        }
 }
 
 client_socket::client_socket(uint16_t c_p, sa_family_t c_d, int c_ty, int c_pr){
@@ -47,138 +44,509 @@ client_socket::client_socket(uint16_t c_p, sa_family_t c_d, int c_ty, int c_pr){
         // Protocol (e.g., Internet Protocol)
         c_protocol = c_pr;
 
-        // Create receive buffer
-        socket_read_buffer = new char[DEFAULT_SOCKET_BUFFER_SIZE];
+        // Receive buffer is leased from the buffer pool by the first c_read()
+        socket_read_buffer = nullptr;
         socket_read_buffer_size = DEFAULT_SOCKET_BUFFER_SIZE;
-        for (int i=0; i<socket_read_buffer_size; i++) {
-                socket_read_buffer[i] = 0;
-        }
 }
 
 
 client_socket::~client_socket(){
-        // Clean up read buffer
-        delete[] socket_read_buffer;
+        // Return read buffer
+        buffer_pool::shared().release(socket_read_buffer, c_read_capacity);
+}
+
+client_socket::client_socket(client_socket&& other) noexcept {
+        *this = std::move(other);
+}
+
+client_socket& client_socket::operator=(client_socket&& other) noexcept {
+        if (this != &other) {
+                buffer_pool::shared().release(socket_read_buffer, c_read_capacity);
+                c_sockfd = other.c_sockfd;
+                c_server = other.c_server;
+                c_server_len = other.c_server_len;
+                c_port = other.c_port;
+                c_domain = other.c_domain;
+                c_type = other.c_type;
+                c_protocol = other.c_protocol;
+                c_framing = other.c_framing;
+                c_options = other.c_options;
+                c_iov_scratch = std::move(other.c_iov_scratch);
+                c_header_scratch = std::move(other.c_header_scratch);
+                socket_read_buffer = other.socket_read_buffer;
+                socket_read_buffer_size = other.socket_read_buffer_size;
+                c_read_capacity = other.c_read_capacity;
+                c_zerocopy = other.c_zerocopy;
+                c_zerocopy_sent = other.c_zerocopy_sent;
+                c_zerocopy_done = other.c_zerocopy_done;
+                c_zerocopy_copied = other.c_zerocopy_copied;
+                c_read_timeout = other.c_read_timeout;
+                c_datagrams = std::move(other.c_datagrams);
+
+                other.c_sockfd = -1;
+                other.socket_read_buffer = nullptr;
+                other.c_read_capacity = 0;
+        }
+        return *this;
 }
 
 // Create socket
 int client_socket::c_create(){
-        return c_sockfd = socket(c_domain, c_type, c_protocol);
+        c_sockfd = socket(c_domain, c_type, c_protocol);
+        if (c_sockfd < 0) {
+                return c_sockfd;
+        }
+        // Failures are only logged, the socket works with the defaults
+        apply_connect_options(c_sockfd, c_options, c_is_tcp());
+        if (c_options.cpu >= 0) {
+                pin_thread(c_options.cpu);
+        }
+        return c_sockfd;
+}
+
+bool client_socket::c_is_tcp(){
+        return c_domain != AF_UNIX && (c_type & ~(SOCK_NONBLOCK | SOCK_CLOEXEC)) == SOCK_STREAM;
 }
 
 // Connect to host $hostname on port $port_input
 int client_socket::c_connect(const char* hostname, uint16_t port_input){
         c_port = port_input;
-        // IPV4
-        c_server.sin_family = c_domain;
-        // Convert port to network byte order (?)
-        c_host = gethostbyname(hostname);
-        if (c_host == nullptr) {
-                int errsv = errno;
-                std::cout << "Host not found: " << hostname << std::endl;
-                std::cout << "Errno: " << errsv << std::endl;
+
+        // hostname is the socket path, nothing to resolve
+        if (c_domain == AF_UNIX) {
+                struct sockaddr_un address;
+                socklen_t length;
+                if ( unix_address(hostname, address, length) < 0 || connect(c_sockfd, (struct sockaddr*) &address, length) < 0 ) {
+                        int errsv = errno;
+                        RSOCKET_LOG_ERROR("Error connecting to %s (errno %d)", hostname, errsv);
+                        errno = errsv;
+                        return -1;
+                }
+                memcpy(&c_server, &address, length);
+                c_server_len = length;
+                return 0;
+        }
+
+        std::vector<resolved_address> addresses;
+        int error = resolver::shared().lookup(hostname, c_port, c_domain, c_type, addresses);
+        if (error != 0) {
+                RSOCKET_LOG_ERROR("Host not found: %s (%s)", hostname, gai_strerror(error));
+                errno = EHOSTUNREACH;
                 return -1;
         }
-        // Taken from: http://www.linuxhowtos.org/C_C++/socket.htm
-        // Copies IP address from c_host struct to c_server struct
-        // (c_host struct contains results of dns query on the hostname, we need to put the IP address into our c_server struct to connect)
-        bcopy(c_host->h_addr,
-              (char *)&c_server.sin_addr.s_addr,
-              (size_t) c_host->h_length);
 
-        // Convert port to network byte order (?)
-        c_server.sin_port = htons( c_port );
+        // Try each address the name resolved to, a socket is not reused after a failed connect()
+        int errsv = 0;
+        for (size_t i = 0; i < addresses.size(); i++) {
+                if (i > 0) {
+                        close(c_sockfd);
+                        if ( c_create() < 0 ) {
+                                errsv = errno;
+                                break;
+                        }
+                }
+                memcpy(&c_server, &addresses[i].address, addresses[i].length);
+                c_server_len = addresses[i].length;
 
-        // Connect to $c_server on socket $c_sockfd
-        if ( connect(c_sockfd,(struct sockaddr*)&c_server,c_server_len) < 0 ) {
+                // Connect to $c_server on socket $c_sockfd
+                if ( connect(c_sockfd, (struct sockaddr*) &c_server, c_server_len) == 0 ) {
+                        return 0;
+                }
+                errsv = errno;
+        }
+        RSOCKET_LOG_ERROR("Error connecting to host: %s (errno %d)", hostname, errsv);
+        errno = errsv;
+        return -1;
+}
+
+int client_socket::c_adopt(int fd){
+        int flags = fcntl(fd, F_GETFL, 0);
+        if ( flags < 0 || fcntl(fd, F_SETFL, flags & ~O_NONBLOCK) < 0 ) {
                 int errsv = errno;
-                std::cout << "Error connecting to host: " << hostname << std::endl;
-                std::cout << "Errno: " << errsv << std::endl;
+                RSOCKET_LOG_ERROR("Failed to adopt socket (errno %d)", errsv);
                 return -1;
-        } else {
-                return 0;
         }
+        c_sockfd = fd;
+        c_server_len = (socklen_t) sizeof(c_server);
+        if ( getpeername(fd, (struct sockaddr*) &c_server, &c_server_len) == 0 ) {
+                c_domain = c_server.ss_family;
+        }
+        apply_accept_options(fd, c_options, c_is_tcp());
+        return 0;
 }
 
 // Read bytes from socket into socket_read_buffer
 int client_socket::c_read(){
-        if ( read(c_sockfd, socket_read_buffer, (size_t) socket_read_buffer_size) < 0) {
+        if (socket_read_buffer == nullptr) {
+                socket_read_buffer = buffer_pool::shared().acquire((size_t) socket_read_buffer_size, c_read_capacity);
+                if (socket_read_buffer == nullptr) {
+                        errno = ENOMEM;
+                        RSOCKET_LOG_ERROR("Out of memory for read buffer");
+                        return -1;
+                }
+        }
+        if (c_read_timeout > 0) {
+                // A stalled server must not block us forever
+                struct pollfd pfd = {c_sockfd, POLLIN, 0};
+                int ready = poll(&pfd, 1, c_read_timeout);
+                if (ready <= 0) {
+                        int errsv = (ready == 0) ? ETIMEDOUT : errno;
+                        RSOCKET_LOG_ERROR("Error reading from host (errno %d)", errsv);
+                        errno = errsv;
+                        return -1;
+                }
+        }
+        long num_bytes = (long) read(c_sockfd, socket_read_buffer, (size_t) socket_read_buffer_size);
+        if (num_bytes < 0) {
                 int errsv = errno;
-                std::cout << "Error reading from host" << std::endl;
-                std::cout << "Errno: " << errsv << std::endl;
+                RSOCKET_LOG_ERROR("Error reading from host (errno %d)", errsv);
                 return -1;
         } else {
+                RSOCKET_COUNT(METRIC_BYTES_IN, num_bytes);
                 return 0;
         }
 }
 
-// Write bytes to socket, appending message length
-// TODO: This has become massively overcomplicated
+// Write bytes to socket, prepending the binary message length
 int client_socket::c_write_len(const char* s_data){
+        return c_write_len(s_data, strlen(s_data));
+}
 
-        //---------------------
-        // Append message length to data so we can separate commands
+// Header and payload go out in one sendmsg() without copying, payload may contain '!' and NUL
+int client_socket::c_write_len(const char* s_data, size_t s_data_length){
+        if (s_data_length > UINT32_MAX) {
+                errno = EMSGSIZE;
+                RSOCKET_LOG_ERROR("Message too long: %zu bytes", s_data_length);
+                return -1;
+        }
 
-        // Get length of data
-        auto s_data_length = (int) strlen(s_data);
-        // Convert int length to char*
-        char s_data_length_char[10];
-        sprintf(s_data_length_char,"%d,",s_data_length);
+        char header[FRAME_HEADER_SIZE];
+        encode_frame_header((uint32_t) s_data_length, header);
 
-        // Get length of the length string (>.>)
-        auto s_length_length = (int) strlen(s_data_length_char);
+        struct iovec iov[2];
+        iov[0].iov_base = header;
+        iov[0].iov_len = FRAME_HEADER_SIZE;
+        iov[1].iov_base = (void*) s_data;
+        iov[1].iov_len = s_data_length;
 
-        // Make new array which will be length of message appended to original data
-        char s_data_new[s_length_length + s_data_length];
+        // Finally send the data
+        if ( send_iov_all(c_sockfd, iov, 2, 0) < 0 ) {
+                int errsv = errno;
+                RSOCKET_LOG_ERROR("Error sending to host (errno %d)", errsv);
+                return -1;
+        } else {
+                RSOCKET_COUNT(METRIC_MESSAGES_OUT, 1);
+                return 0;
+        }
+}
 
-        // Create new array [length,data1,data2,...]
-        std::copy(s_data_length_char, s_data_length_char + s_length_length, s_data_new);
-        // +1 to catch the null character
-        std::copy(s_data, s_data + s_data_length+1, s_data_new + s_length_length);
+// Write bytes to socket with delimiter '!'
+int client_socket::c_write_delim(const char* s_data){
+        static const char delim = '!';
 
-        // Convert to const char* to send
-        const char* s_data_new_const = s_data_new;
-        //---------------------
+        struct iovec iov[2];
+        iov[0].iov_base = (void*) s_data;
+        iov[0].iov_len = strlen(s_data);
+        iov[1].iov_base = (void*) &delim;
+        iov[1].iov_len = 1;
 
         // Finally send the data
-        if ( write(c_sockfd, s_data_new_const, strlen(s_data_new_const)) < 0 ) {
+        if ( send_iov_all(c_sockfd, iov, 2, 0) < 0 ) {
                 int errsv = errno;
-                std::cout << "Error sending to host" << std::endl;
-                std::cout << "Errno: " << errsv << std::endl;
-                std::cout << "Data: \n" << s_data << std::endl;
+                RSOCKET_LOG_ERROR("Error sending to host (errno %d)", errsv);
+                RSOCKET_LOG_TRACE("Data: %s", s_data);
                 return -1;
         } else {
+                RSOCKET_COUNT(METRIC_MESSAGES_OUT, 1);
                 return 0;
         }
 }
 
-// Write bytes to socket with delimiter '!'
-int client_socket::c_write_delim(const char* s_data){
+// Write one message using the configured framing
+int client_socket::c_write_frame(const char* s_data, size_t s_data_length){
+        if (c_framing == FRAMING_LENGTH_PREFIXED) {
+                return c_write_len(s_data, s_data_length);
+        }
+        frame_view message = {s_data, s_data_length};
+        return c_write_batch(&message, 1);
+}
+
+int client_socket::c_write_batch(const std::vector<frame_view>& messages, bool more){
+        return c_write_batch(messages.data(), messages.size(), more);
+}
+
+// Headers (or delimiters) and payloads are interleaved as iovecs, one sendmsg() per SEND_IOV_MAX / 2 messages
+int client_socket::c_write_batch(const frame_view* messages, size_t count, bool more){
+        static const char delim = '!';
+        bool length_prefixed = (c_framing == FRAMING_LENGTH_PREFIXED);
 
-        auto s_data_length = (int) strlen(s_data);
+        c_iov_scratch.resize(count * 2);
+        if (length_prefixed) {
+                c_header_scratch.resize(count * FRAME_HEADER_SIZE);
+        }
 
-        // Make new array which will of size strlen(message) + 2 (! and \0)
-        char s_data_new[s_data_length + 2];
-        char delim[2] = {'!','\0'};
+        for (size_t i = 0; i < count; i++) {
+                const frame_view& message = messages[i];
+                struct iovec* iov = &c_iov_scratch[i * 2];
+                if (length_prefixed) {
+                        if (message.size > UINT32_MAX) {
+                                errno = EMSGSIZE;
+                                RSOCKET_LOG_ERROR("Message too long: %zu bytes", message.size);
+                                return -1;
+                        }
+                        char* header = &c_header_scratch[i * FRAME_HEADER_SIZE];
+                        encode_frame_header((uint32_t) message.size, header);
+                        iov[0].iov_base = header;
+                        iov[0].iov_len = FRAME_HEADER_SIZE;
+                        iov[1].iov_base = (void*) message.data;
+                        iov[1].iov_len = message.size;
+                } else {
+                        if ( memchr(message.data, '!', message.size) != nullptr || memchr(message.data, '\0', message.size) != nullptr ) {
+                                errno = EINVAL;
+                                RSOCKET_LOG_ERROR("Delimited messages cannot contain '!' or NUL");
+                                return -1;
+                        }
+                        iov[0].iov_base = (void*) message.data;
+                        iov[0].iov_len = message.size;
+                        iov[1].iov_base = (void*) &delim;
+                        iov[1].iov_len = 1;
+                }
+        }
 
-        // Append '!' to char array
-        std::strcpy(s_data_new,s_data);
-        std::strcat(s_data_new,delim);
+        if ( send_iov_all(c_sockfd, c_iov_scratch.data(), (int) c_iov_scratch.size(), more ? MSG_MORE : 0) < 0 ) {
+                int errsv = errno;
+                RSOCKET_LOG_ERROR("Error sending to host (errno %d)", errsv);
+                return -1;
+        }
+        RSOCKET_COUNT(METRIC_MESSAGES_OUT, count);
+        return 0;
+}
 
-        // Convert to const char* to send
-        const char* s_data_new_const = s_data_new;
-        //---------------------
+// Header (or delimiter) is sent with MSG_MORE so it shares a segment with the first file pages
+int client_socket::c_send_file(int file_fd, off_t offset, size_t length){
+        static const char delim = '!';
+        bool length_prefixed = (c_framing == FRAMING_LENGTH_PREFIXED);
+        if (length_prefixed && length > UINT32_MAX) {
+                errno = EMSGSIZE;
+                RSOCKET_LOG_ERROR("Message too long: %zu bytes", length);
+                return -1;
+        }
 
-        // Finally send the data
-        if ( write(c_sockfd, s_data_new_const, strlen(s_data_new_const)) < 0 ) {
+        char header[FRAME_HEADER_SIZE];
+        struct iovec iov;
+        if (length_prefixed) {
+                encode_frame_header((uint32_t) length, header);
+                iov.iov_base = header;
+                iov.iov_len = FRAME_HEADER_SIZE;
+                if ( send_iov_all(c_sockfd, &iov, 1, MSG_MORE) < 0 ) {
+                        int errsv = errno;
+                        RSOCKET_LOG_ERROR("Error sending to host (errno %d)", errsv);
+                        return -1;
+                }
+        }
+        if ( send_file_all(c_sockfd, file_fd, offset, length) < 0 ) {
                 int errsv = errno;
-                std::cout << "Error sending to host" << std::endl;
-                std::cout << "Errno: " << errsv << std::endl;
-                std::cout << "Data: \n" << s_data << std::endl;
+                RSOCKET_LOG_ERROR("Error sending file to host (errno %d)", errsv);
+                return -1;
+        }
+        if (!length_prefixed) {
+                iov.iov_base = (void*) &delim;
+                iov.iov_len = 1;
+                if ( send_iov_all(c_sockfd, &iov, 1, 0) < 0 ) {
+                        int errsv = errno;
+                        RSOCKET_LOG_ERROR("Error sending to host (errno %d)", errsv);
+                        return -1;
+                }
+        }
+        RSOCKET_COUNT(METRIC_MESSAGES_OUT, 1);
+        return 0;
+}
+
+int client_socket::c_enable_zerocopy(){
+        if ( enable_zerocopy(c_sockfd) < 0 ) {
+                int errsv = errno;
+                RSOCKET_LOG_ERROR("Zero copy not supported on this socket (errno %d)", errsv);
+                errno = errsv;
+                return -1;
+        }
+        c_zerocopy = true;
+        return 0;
+}
+
+int client_socket::c_send_buffer(const char* data, size_t length){
+        if ( !c_zerocopy || length < ZEROCOPY_MIN_SIZE ) {
+                return c_write_frame(data, length);
+        }
+
+        static const char delim = '!';
+        bool length_prefixed = (c_framing == FRAMING_LENGTH_PREFIXED);
+        if (length_prefixed && length > UINT32_MAX) {
+                errno = EMSGSIZE;
+                RSOCKET_LOG_ERROR("Message too long: %zu bytes", length);
+                return -1;
+        }
+
+        // Pinned pages are read whenever the packet goes out, so only the caller's payload may be sent
+        // zero copy, the header on this stack is copied (MSG_MORE keeps it in the payload's first segment)
+        char header[FRAME_HEADER_SIZE];
+        struct iovec iov[2];
+        if (length_prefixed) {
+                encode_frame_header((uint32_t) length, header);
+                iov[0].iov_base = header;
+                iov[0].iov_len = FRAME_HEADER_SIZE;
+                if ( send_iov_all(c_sockfd, iov, 1, MSG_MORE) < 0 ) {
+                        int errsv = errno;
+                        RSOCKET_LOG_ERROR("Error sending to host (errno %d)", errsv);
+                        return -1;
+                }
+        }
+        int iovcnt = 0;
+        iov[iovcnt].iov_base = (void*) data;
+        iov[iovcnt++].iov_len = length;
+        if (!length_prefixed) {
+                // Static, never changes
+                iov[iovcnt].iov_base = (void*) &delim;
+                iov[iovcnt++].iov_len = 1;
+        }
+
+        // Keep the error queue short so the kernel doesn't run out of notification memory
+        c_zerocopy_pending();
+        if ( send_zerocopy_all(c_sockfd, iov, iovcnt, 0, &c_zerocopy_sent) < 0 ) {
+                int errsv = errno;
+                RSOCKET_LOG_ERROR("Error sending to host (errno %d)", errsv);
+                return -1;
+        }
+        RSOCKET_COUNT(METRIC_MESSAGES_OUT, 1);
+        return 0;
+}
+
+size_t client_socket::c_zerocopy_pending(){
+        if (c_zerocopy_done < c_zerocopy_sent) {
+                long completed = reap_zerocopy(c_sockfd, &c_zerocopy_copied);
+                if (completed > 0) {
+                        c_zerocopy_done += (uint64_t) completed;
+                }
+        }
+        return (size_t) (c_zerocopy_sent - c_zerocopy_done);
+}
+
+// Completions are queued on the socket error queue, which poll() reports as POLLERR
+int client_socket::c_zerocopy_wait(int timeout){
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+        while ( c_zerocopy_pending() > 0 ) {
+                int wait = -1;
+                if (timeout >= 0) {
+                        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+                        if (left <= 0) {
+                                errno = ETIMEDOUT;
+                                return -1;
+                        }
+                        wait = (int) left;
+                }
+                struct pollfd pfd = {c_sockfd, 0, 0};
+                if ( poll(&pfd, 1, wait) < 0 && errno != EINTR ) {
+                        return -1;
+                }
+        }
+        return 0;
+}
+
+// Views into the callers' messages, DATAGRAM_BATCH_SIZE at a time
+int client_socket::c_send_datagrams(const frame_view* messages, size_t count){
+        datagram batch[DATAGRAM_BATCH_SIZE];
+        for (size_t first = 0; first < count; first += DATAGRAM_BATCH_SIZE) {
+                size_t batch_count = std::min(count - first, (size_t) DATAGRAM_BATCH_SIZE);
+                for (size_t i = 0; i < batch_count; i++) {
+                        batch[i].data = messages[first + i].data;
+                        batch[i].size = messages[first + i].size;
+                }
+                long sent = send_datagrams(c_sockfd, batch, batch_count);
+                if ( sent < (long) batch_count ) {
+                        int errsv = (sent < 0) ? errno : EIO;
+                        RSOCKET_LOG_ERROR("Error sending datagrams to host (errno %d)", errsv);
+                        errno = errsv;
+                        return -1;
+                }
+        }
+        return 0;
+}
+
+int client_socket::c_send_segments(const char* data, size_t length, size_t segment_size){
+        long sent = send_segments(c_sockfd, data, length, segment_size);
+        if ( sent < 0 || (size_t) sent * segment_size < length ) {
+                int errsv = (sent < 0) ? errno : EIO;
+                RSOCKET_LOG_ERROR("Error sending datagrams to host (errno %d)", errsv);
+                errno = errsv;
+                return -1;
+        }
+        return 0;
+}
+
+long client_socket::c_recv_datagrams(std::vector<datagram>& datagrams, int timeout){
+        datagrams.clear();
+        long received = c_datagrams.receive(c_sockfd, datagrams);
+        if ( received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) ) {
+                struct pollfd pfd = {c_sockfd, POLLIN, 0};
+                int ready = poll(&pfd, 1, timeout);
+                if (ready <= 0) {
+                        return (ready == 0 || errno == EINTR) ? 0 : -1;
+                }
+                received = c_datagrams.receive(c_sockfd, datagrams);
+        }
+        if (received < 0) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                        return 0;
+                }
+                int errsv = errno;
+                RSOCKET_LOG_ERROR("Error receiving datagrams (errno %d)", errsv);
+                errno = errsv;
+        }
+        return received;
+}
+
+int client_socket::c_enable_gro(){
+        if ( enable_gro(c_sockfd) < 0 ) {
+                return -1;
+        }
+        c_datagrams.release();
+        c_datagrams.batch_size = DATAGRAM_GRO_BATCH_SIZE;
+        c_datagrams.slot_size = DATAGRAM_GRO_SLOT_SIZE;
+        return 0;
+}
+
+int client_socket::c_open_shm(shm_channel& channel, size_t capacity){
+        if (c_domain != AF_UNIX) {
+                errno = EAFNOSUPPORT;
+                RSOCKET_LOG_ERROR("Shared memory channels need an AF_UNIX connection");
+                return -1;
+        }
+        if ( channel.create(capacity) < 0 || channel.offer(c_sockfd) < 0 ) {
+                channel.close();
+                return -1;
+        }
+        return 0;
+}
+
+int client_socket::c_cork(){
+        int on = 1;
+        return setsockopt(c_sockfd, IPPROTO_TCP, TCP_CORK, (char *)&on, sizeof(on));
+}
+
+// Flushes anything held back while corked
+int client_socket::c_uncork(){
+        int off = 0;
+        return setsockopt(c_sockfd, IPPROTO_TCP, TCP_CORK, (char *)&off, sizeof(off));
+}
+
+// Switch this connection to length-prefixed framing
+int client_socket::c_negotiate_framing(){
+        if ( write(c_sockfd, FRAME_PREAMBLE, FRAME_PREAMBLE_SIZE) < 0 ) {
+                int errsv = errno;
+                RSOCKET_LOG_ERROR("Error sending to host (errno %d)", errsv);
                 return -1;
-        } else {
-                return 0;
         }
+        c_framing = FRAMING_LENGTH_PREFIXED;
+        return 0;
 }
 
 // Convert string to const char[] and write to socket
@@ -187,16 +555,24 @@ int client_socket::send_string(std::string data_string){
 
         if ( c_write_delim(data_c_str) < 0 ) {
                 int errsv = errno;
-                std::cout << "Failed to send data" << std::endl;
-                std::cout << "Errno: " << errsv << std::endl;
+                RSOCKET_LOG_ERROR("Failed to send data (errno %d)", errsv);
                 return -1;
         } else {
-                std::cout << "Data sent." << std::endl;
+                RSOCKET_LOG_TRACE("Data sent.");
                 return 0;
         }
 }
 
-// Close socket
+// Close socket, the read buffer goes back to the pool
 void client_socket::c_close(){
         close(c_sockfd);
+        c_sockfd = -1;
+        buffer_pool::shared().release(socket_read_buffer, c_read_capacity);
+        socket_read_buffer = nullptr;
+        c_read_capacity = 0;
+        c_zerocopy = false;
+        c_zerocopy_sent = 0;
+        c_zerocopy_done = 0;
+        c_zerocopy_copied = 0;
+        c_datagrams.release();
 }
@@ -8,7 +8,7 @@
 // Email: lmbernar@uark.edu
 //
 // Created July 20th, 2018
-// Modified: November 7th, 2018
+// Modified: October 17th, 2026
 // Version 0.5
 //--------------------------
 
@@ -38,20 +38,33 @@
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <netdb.h>
+#include <fcntl.h>
 
 // Read / write
 #include <unistd.h>
+#include <sys/uio.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <chrono>
+#include <vector>
+
+#include "buffer_pool.h"
+#include "datagram.h"
+#include "framing.h"
+#include "logger.h"
+#include "resolver.h"
+#include "shm_channel.h"
+#include "socket_io.h"
+#include "socket_options.h"
 
 class client_socket
 {
 public:
         // Socket file descriptor
-        int c_sockfd = 0;
-        // netinet/in.h defined address struct
-        struct sockaddr_in c_server;
+        int c_sockfd = -1;
+        // Address of the server we connected to (IPv4 or IPv6)
+        struct sockaddr_storage c_server;
         socklen_t c_server_len = (socklen_t) sizeof(c_server);
-        // Host struct
-        struct hostent *c_host;
 
         // Socket port
         uint16_t c_port;
@@ -61,34 +74,140 @@ public:
         int c_type;
         // Protocol (e.g., Internet Protocol)
         int c_protocol;
-
-        // "Receive" buffer
-        char* socket_read_buffer;
+        // Framing used by c_write_frame() / c_write_batch()
+        framing_mode c_framing = FRAMING_DELIMITED;
+        // Socket tuning applied by c_create() (and the post-connect part by c_adopt()),
+        // e.g., socket_options::low_latency()
+        socket_options c_options;
+
+        // Reused by c_write_batch() so batching doesn't allocate in steady state
+        std::vector<struct iovec> c_iov_scratch;
+        std::vector<char> c_header_scratch;
+
+        // "Receive" buffer, leased from buffer_pool by the first c_read() and returned by c_close()
+        char* socket_read_buffer = nullptr;
         int socket_read_buffer_size;
+        // Capacity of the leased buffer (may exceed socket_read_buffer_size)
+        size_t c_read_capacity = 0;
+
+        // Set by c_enable_zerocopy()
+        bool c_zerocopy = false;
+        // MSG_ZEROCOPY sends issued / completed by the kernel
+        uint64_t c_zerocopy_sent = 0;
+        uint64_t c_zerocopy_done = 0;
+        // Completed sends the kernel had to copy anyway (e.g., loopback), zero copy doesn't pay off if this keeps up with c_zerocopy_done
+        uint64_t c_zerocopy_copied = 0;
+
+        // Time (ms) c_read() waits for the server before failing with ETIMEDOUT, 0 = wait forever
+        int c_read_timeout = 0;
+
+        // Receive slots of a datagram client, leased by the first c_recv_datagrams() and returned by c_close()
+        datagram_batch c_datagrams;
 
         client_socket();
         client_socket(uint16_t c_p, sa_family_t c_d, int c_ty, int c_pr);
         ~client_socket();
 
-        // Create socket
+        // Move-only, a copy would share (and double free) the read buffer
+        client_socket(const client_socket&) = delete;
+        client_socket& operator=(const client_socket&) = delete;
+        client_socket(client_socket&& other) noexcept;
+        client_socket& operator=(client_socket&& other) noexcept;
+
+        // Create socket and apply c_options
         int c_create();
 
+        // c_domain / c_type describe a TCP socket (TCP options apply)
+        bool c_is_tcp();
+
         // Connect to host $hostname on port $port_input
+        // Resolves with getaddrinfo() (cached, see resolver.h) and tries each c_domain address in turn
+        // With c_domain AF_UNIX hostname is the socket path instead ('@' prefix: abstract namespace), port_input is ignored
+        // Blocks until connected, use connector to open many connections in parallel
         // Verbose
         int c_connect(const char* hostname, uint16_t port_input);
 
-        // Read from socket into socket_read_buffer
+        // Take over a socket connected elsewhere (e.g., by connector), switching it back to blocking mode
+        // Only the c_options that still matter after connect() (TCP_NODELAY, TCP_QUICKACK) are applied
+        int c_adopt(int fd);
+
+        // Read from socket into socket_read_buffer, waiting at most c_read_timeout ms
         // Verbose
         int c_read();
 
-        // Write to socket (prepend message length)
+        // Write to socket (prepend binary message length, see framing.h)
         // Verbose
         int c_write_len(const char* data);
+        int c_write_len(const char* data, size_t length);
 
         // Write to socket (append delimiter '!')
         // Verbose
         int c_write_delim(const char* data);
 
+        // Write one message using c_framing
+        // Verbose
+        int c_write_frame(const char* data, size_t length);
+
+        // Tell a FRAMING_AUTO server that this connection is length-prefixed and switch c_framing to match
+        // Must be the first thing sent after c_connect()
+        int c_negotiate_framing();
+
+        // Send many messages (framed with c_framing) in as few syscalls as possible, payloads are not copied
+        // Partial writes are resumed until everything is sent
+        // more = true passes MSG_MORE so the kernel can coalesce this batch with the next send
+        // Verbose
+        int c_write_batch(const frame_view* messages, size_t count, bool more = false);
+        int c_write_batch(const std::vector<frame_view>& messages, bool more = false);
+
+        // Send length bytes of file_fd from offset as one message (c_framing) with sendfile() / splice(),
+        // the payload never passes through user space. Blocks until everything is sent
+        // Receivers buffer whole messages (recv_buffer max_capacity), stream big files as a series of ranges
+        // Verbose
+        int c_send_file(int file_fd, off_t offset, size_t length);
+
+        // Pin the pages of later c_send_buffer() payloads instead of copying them (SO_ZEROCOPY, TCP only)
+        int c_enable_zerocopy();
+
+        // Send one message (c_framing) of arbitrary binary data
+        // With zero copy enabled, payloads of at least ZEROCOPY_MIN_SIZE go out with MSG_ZEROCOPY and must not be
+        // modified or freed until c_zerocopy_pending() reaches 0 (or c_zerocopy_wait() returns 0)
+        // Verbose
+        int c_send_buffer(const char* data, size_t length);
+
+        // Zero copy sends the kernel hasn't released yet, collects completions without blocking
+        size_t c_zerocopy_pending();
+
+        // Wait up to timeout ms (-1 = forever) until no zero copy send is pending, 0 or -1 (errno ETIMEDOUT)
+        int c_zerocopy_wait(int timeout);
+
+        // Datagram clients (c_type SOCK_DGRAM): c_connect() only sets the server as the default destination
+
+        // Send each message as one datagram to the server, sendmmsg() batches
+        // Verbose
+        int c_send_datagrams(const frame_view* messages, size_t count);
+
+        // Send length bytes as datagrams of segment_size bytes, segmented by the kernel where possible (UDP GSO)
+        // Verbose
+        int c_send_segments(const char* data, size_t length, size_t segment_size);
+
+        // Wait up to timeout ms (-1 = forever) for datagrams and receive a batch with one recvmmsg(),
+        // replacing the contents of datagrams. Views stay valid until the next call
+        // Returns the number received, 0 on timeout, -1 on error
+        long c_recv_datagrams(std::vector<datagram>& datagrams, int timeout);
+
+        // Receive coalesced datagrams (UDP_GRO), switches c_datagrams to the DATAGRAM_GRO_* sizes
+        int c_enable_gro();
+
+        // Same-host fast path (c_domain AF_UNIX): create shared memory rings of capacity bytes per direction and
+        // hand them to the server (server_socket::s_accept_shm()). Must be the first thing sent after c_connect()
+        // Messages then go through channel instead of the socket, keep the socket open to notice a dead server
+        // Verbose
+        int c_open_shm(shm_channel& channel, size_t capacity = DEFAULT_SHM_RING_SIZE);
+
+        // Hold back partial frames (TCP_CORK) until c_uncork(), for many small writes outside c_write_batch()
+        int c_cork();
+        int c_uncork();
+
         // Convert string into const char[] and c_write to socket
         // Verbose
         int send_string(std::string data_string);
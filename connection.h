@@ -0,0 +1,71 @@
+//--------------------------
+// Connection module header
+//--------------------------
+// Description:
+// Per-client state kept by server_socket
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#ifndef _connection_H_INCLUDED
+#define _connection_H_INCLUDED
+
+// Includes
+//-----------------------------
+#include <cstdint>
+
+#include "recv_buffer.h"
+#include "send_queue.h"
+#include "timer_wheel.h"
+//-----------------------------
+
+// Traffic of one connection since it was accepted, see server_socket::s_connection_stats()
+struct connection_stats
+{
+        uint64_t bytes_in = 0;
+        uint64_t bytes_out = 0;
+        uint64_t messages_in = 0;
+        uint64_t messages_out = 0;
+};
+
+struct connection
+{
+        // Client socket file descriptor
+        int fd = -1;
+        // Received bytes not yet consumed as messages
+        recv_buffer rx;
+        // Framed messages waiting for the socket to become writable
+        send_queue tx;
+        // Output queue passed the high watermark and has not drained to the low watermark yet
+        bool tx_blocked = false;
+        connection_stats stats;
+        // When the client last became readable (metrics_now_us()), 0 once a read picked it up
+        uint64_t ready_at = 0;
+        // errno the read side reports once the connection broke (send failure, io_uring receive, timeout)
+        int rx_error = 0;
+
+        // Timers in server_socket's wheel (idle timeout, read / write deadline, heartbeat), unset when off
+        timer_handle idle_timer;
+        timer_handle read_timer;
+        timer_handle write_timer;
+        timer_handle heartbeat_timer;
+        // When (timer_now_ms()) the client last sent us data, we last queued a message for it,
+        // and its output queue last moved
+        uint64_t last_read = 0;
+        uint64_t last_write = 0;
+        uint64_t last_progress = 0;
+
+        // io_uring engine only
+        // Bytes received since the last s_read_frames(), peer closed
+        size_t rx_new = 0;
+        bool rx_eof = false;
+        // Registered buffer holding the send in flight (-1 if none)
+        int tx_buffer = -1;
+};
+
+#endif // connection.h
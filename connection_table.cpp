@@ -0,0 +1,90 @@
+//--------------------------
+// Connection table module
+//--------------------------
+// Description:
+// Slot map of client connections with O(1) add / remove / lookup and stable handles
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#include "connection_table.h"
+
+// End of the free slot list
+#define NO_SLOT UINT32_MAX
+
+//-----------------------------
+// Class: connection_table
+//-----------------------------
+
+connection_table::connection_table(){
+        free_head = NO_SLOT;
+}
+
+int connection_table::insert(int fd){
+        uint32_t index;
+        if (free_head != NO_SLOT) {
+                index = free_head;
+                free_head = slots[index].dense;
+        } else {
+                index = (uint32_t) slots.size();
+                slots.push_back(slot{0, 0, false});
+        }
+
+        slots[index].dense = (uint32_t) connections.size();
+        slots[index].alive = true;
+        connections.emplace_back();
+        connections.back().fd = fd;
+        dense_slots.push_back(index);
+        return (int) index;
+}
+
+void connection_table::erase(int index){
+        if ( !contains(index) ) {
+                return;
+        }
+        uint32_t dense = slots[index].dense;
+        uint32_t last = (uint32_t) connections.size() - 1;
+
+        // Fill the hole with the last connection
+        if (dense != last) {
+                connections[dense] = std::move(connections[last]);
+                dense_slots[dense] = dense_slots[last];
+                slots[dense_slots[dense]].dense = dense;
+        }
+        connections.pop_back();
+        dense_slots.pop_back();
+
+        slots[index].alive = false;
+        slots[index].generation++;
+        slots[index].dense = free_head;
+        free_head = (uint32_t) index;
+}
+
+bool connection_table::contains(int index){
+        return index >= 0 && index < (int) slots.size() && slots[index].alive;
+}
+
+bool connection_table::valid(client_handle handle){
+        return contains((int) handle.index) && slots[handle.index].generation == handle.generation;
+}
+
+client_handle connection_table::handle(int index){
+        return client_handle{(uint32_t) index, slots[index].generation};
+}
+
+connection& connection_table::operator[](int index){
+        return connections[slots[index].dense];
+}
+
+int connection_table::size(){
+        return (int) connections.size();
+}
+
+int connection_table::index_at(int position){
+        return (int) dense_slots[position];
+}
@@ -0,0 +1,79 @@
+//--------------------------
+// Connection table module header
+//--------------------------
+// Description:
+// Slot map of client connections with O(1) add / remove / lookup and stable handles
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#ifndef _connection_table_H_INCLUDED
+#define _connection_table_H_INCLUDED
+
+// Includes
+//-----------------------------
+#include <cstdint>
+#include <vector>
+
+#include "connection.h"
+//-----------------------------
+
+// Identifies one connection for its whole lifetime
+// index is reused once the connection is removed, generation tells the old and new occupant apart
+struct client_handle
+{
+        uint32_t index;
+        uint32_t generation;
+};
+
+// Connections are stored densely (removal swaps the last one into the hole) so iteration is a linear scan,
+// slots map the stable index to the current dense position
+class connection_table
+{
+    private:
+        struct slot
+        {
+                // Position in connections while alive, next free slot while free
+                uint32_t dense;
+                // Bumped on every removal so stale handles stop matching
+                uint32_t generation;
+                bool alive;
+        };
+
+        std::vector<slot> slots;
+        std::vector<connection> connections;
+        // Slot index of each dense entry
+        std::vector<uint32_t> dense_slots;
+        // Head of the free slot list
+        uint32_t free_head;
+
+    public:
+        connection_table();
+
+        // Add a connection for fd, returns its slot index
+        int insert(int fd);
+
+        // Remove the connection in slot index (no-op if the slot is free)
+        void erase(int index);
+
+        bool contains(int index);
+        bool valid(client_handle handle);
+
+        client_handle handle(int index);
+
+        // Connection in slot index, which must be alive
+        connection& operator[](int index);
+
+        int size();
+
+        // Slot index of the position-th connection in dense order (0 <= position < size())
+        // Positions change when connections are removed, slot indices don't
+        int index_at(int position);
+};
+
+#endif // connection_table.h
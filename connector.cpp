@@ -0,0 +1,267 @@
+//--------------------------
+// Connector module
+//--------------------------
+// Description:
+// Opens many outgoing connections in parallel: asynchronous name resolution,
+// non-blocking connect() completed through epoll, per-connection timeouts
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#include "connector.h"
+
+// epoll data of the eventfd the resolver threads signal, request ids start at 1
+#define CONNECTOR_WAKE_ID 0
+
+//-----------------------------
+// Class: connector
+//-----------------------------
+
+connector::connector() : connector(resolver::shared()) {
+}
+
+connector::connector(resolver& r) : names(r), inbox(std::make_shared<resolved_inbox>()) {
+}
+
+connector::~connector(){
+        {
+                // Lookups still in flight drop their results
+                std::lock_guard<std::mutex> guard(inbox->lock);
+                inbox->closed = true;
+                if (inbox->wakefd >= 0) {
+                        close(inbox->wakefd);
+                        inbox->wakefd = -1;
+                }
+        }
+        for (auto& request : requests) {
+                if (request.second.fd >= 0) {
+                        close(request.second.fd);
+                }
+        }
+        if (epollfd >= 0) {
+                close(epollfd);
+        }
+}
+
+int connector::init(){
+        epollfd = epoll_create1(EPOLL_CLOEXEC);
+        if (epollfd < 0) {
+                int errsv = errno;
+                RSOCKET_LOG_ERROR("Failed to create epoll instance (errno %d)", errsv);
+                return -1;
+        }
+        inbox->wakefd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (inbox->wakefd < 0) {
+                return -1;
+        }
+        struct epoll_event event;
+        event.events = EPOLLIN;
+        event.data.u64 = CONNECTOR_WAKE_ID;
+        if ( epoll_ctl(epollfd, EPOLL_CTL_ADD, inbox->wakefd, &event) < 0 ) {
+                return -1;
+        }
+        events.resize(DEFAULT_CONNECT_EVENTS);
+        return 0;
+}
+
+uint64_t connector::connect_to(const char* hostname, uint16_t port, int timeout, connect_callback callback){
+        if (epollfd < 0) {
+                errno = EBADF;
+                return 0;
+        }
+        uint64_t id = next_id++;
+        pending_connect& request = requests[id];
+        request.host = hostname;
+        request.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+        request.callback = std::move(callback);
+        deadlines.push(std::make_pair(request.deadline, id));
+
+        // Resolver threads only ever touch the inbox, never the connector itself
+        std::shared_ptr<resolved_inbox> target = inbox;
+        names.resolve(hostname, port, c_domain, c_type,
+                      [target, id](int error, const std::vector<resolved_address>& addresses) {
+                std::lock_guard<std::mutex> guard(target->lock);
+                if (target->closed) {
+                        return;
+                }
+                target->results.push_back(resolved_inbox::resolution{id, error, addresses});
+                uint64_t one = 1;
+                if ( write(target->wakefd, &one, sizeof(one)) < 0 ) {
+                        // Counter already non-zero, poll() will look at the inbox anyway
+                }
+        });
+        return id;
+}
+
+std::future<connect_result> connector::connect_to(const char* hostname, uint16_t port, int timeout){
+        std::shared_ptr<std::promise<connect_result>> promise = std::make_shared<std::promise<connect_result>>();
+        std::future<connect_result> result = promise->get_future();
+        if ( connect_to(hostname, port, timeout, [promise](int fd, int error) {
+                promise->set_value(connect_result{fd, error});
+        }) == 0 ) {
+                promise->set_value(connect_result{-1, errno});
+        }
+        return result;
+}
+
+void connector::cancel(uint64_t id){
+        auto request = requests.find(id);
+        if (request == requests.end()) {
+                return;
+        }
+        if (request->second.fd >= 0) {
+                close(request->second.fd);
+        }
+        requests.erase(request);
+}
+
+void connector::resolved(uint64_t id, int error, std::vector<resolved_address>& addresses){
+        auto request = requests.find(id);
+        if (request == requests.end()) {
+                // Timed out or cancelled while resolving
+                return;
+        }
+        if (error != 0) {
+                RSOCKET_LOG_ERROR("Host not found: %s (%s)", request->second.host.c_str(), gai_strerror(error));
+                finish(id, -1, EHOSTUNREACH);
+                return;
+        }
+        request->second.addresses.swap(addresses);
+        try_next(id);
+}
+
+// Start a non-blocking connect to the next address, finish the request once none are left
+void connector::try_next(uint64_t id){
+        pending_connect& request = requests[id];
+        while (request.next < request.addresses.size()) {
+                const resolved_address& address = request.addresses[request.next++];
+                int fd = socket(address.family, address.type | SOCK_NONBLOCK | SOCK_CLOEXEC, address.protocol);
+                if (fd < 0) {
+                        request.error = errno;
+                        continue;
+                }
+                if ( ::connect(fd, (const struct sockaddr*) &address.address, address.length) == 0 ) {
+                        // Loopback connects can finish immediately
+                        finish(id, fd, 0);
+                        return;
+                }
+                if (errno == EINPROGRESS) {
+                        struct epoll_event event;
+                        event.events = EPOLLOUT;
+                        event.data.u64 = id;
+                        if ( epoll_ctl(epollfd, EPOLL_CTL_ADD, fd, &event) == 0 ) {
+                                request.fd = fd;
+                                return;
+                        }
+                }
+                request.error = errno;
+                close(fd);
+        }
+        finish(id, -1, (request.error != 0) ? request.error : ECONNREFUSED);
+}
+
+// Callback runs after the request is gone, so it may start new connects
+void connector::finish(uint64_t id, int fd, int error){
+        auto request = requests.find(id);
+        connect_callback callback = std::move(request->second.callback);
+        if (error != 0) {
+                RSOCKET_LOG_DEBUG("Connect to %s failed (errno %d)", request->second.host.c_str(), error);
+        }
+        requests.erase(request);
+        finished++;
+        callback(fd, error);
+}
+
+void connector::expire(){
+        time_point now = std::chrono::steady_clock::now();
+        while ( !deadlines.empty() && deadlines.top().first <= now ) {
+                uint64_t id = deadlines.top().second;
+                deadlines.pop();
+                auto request = requests.find(id);
+                if (request == requests.end()) {
+                        continue;
+                }
+                if (request->second.fd >= 0) {
+                        close(request->second.fd);
+                }
+                finish(id, -1, ETIMEDOUT);
+        }
+}
+
+int connector::poll(int timeout){
+        // Finished requests leave their deadline behind, drop those first
+        while ( !deadlines.empty() && requests.count(deadlines.top().second) == 0 ) {
+                deadlines.pop();
+        }
+        if ( !deadlines.empty() ) {
+                auto until = std::chrono::duration_cast<std::chrono::milliseconds>(deadlines.top().first - std::chrono::steady_clock::now()).count() + 1;
+                if (until < 0) {
+                        until = 0;
+                }
+                if (timeout < 0 || until < timeout) {
+                        timeout = (int) until;
+                }
+        }
+
+        int n = epoll_wait(epollfd, events.data(), (int) events.size(), timeout);
+        if (n < 0) {
+                if (errno != EINTR) {
+                        int errsv = errno;
+                        RSOCKET_LOG_ERROR("epoll_wait failed (errno %d)", errsv);
+                        return -1;
+                }
+                n = 0;
+        }
+
+        finished = 0;
+        for (int i = 0; i < n; i++) {
+                uint64_t id = events[i].data.u64;
+                if (id == CONNECTOR_WAKE_ID) {
+                        std::vector<resolved_inbox::resolution> results;
+                        {
+                                std::lock_guard<std::mutex> guard(inbox->lock);
+                                uint64_t count;
+                                if ( read(inbox->wakefd, &count, sizeof(count)) < 0 ) {
+                                        // Already drained
+                                }
+                                results.swap(inbox->results);
+                        }
+                        for (auto& result : results) {
+                                resolved(result.id, result.error, result.addresses);
+                        }
+                        continue;
+                }
+
+                auto request = requests.find(id);
+                if (request == requests.end()) {
+                        continue;
+                }
+                int fd = request->second.fd;
+                int error = 0;
+                socklen_t length = sizeof(error);
+                if ( getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length) < 0 ) {
+                        error = errno;
+                }
+                epoll_ctl(epollfd, EPOLL_CTL_DEL, fd, nullptr);
+                request->second.fd = -1;
+                if (error == 0) {
+                        finish(id, fd, 0);
+                } else {
+                        // Refused / unreachable, move on to the next address
+                        close(fd);
+                        request->second.error = error;
+                        try_next(id);
+                }
+        }
+        expire();
+        return finished;
+}
+
+size_t connector::pending(){
+        return requests.size();
+}
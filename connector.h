@@ -0,0 +1,148 @@
+//--------------------------
+// Connector module header
+//--------------------------
+// Description:
+// Opens many outgoing connections in parallel: asynchronous name resolution,
+// non-blocking connect() completed through epoll, per-connection timeouts
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#ifndef _connector_H_INCLUDED
+#define _connector_H_INCLUDED
+
+// Default settings
+//-----------------------------
+// Default time (ms) allowed for resolving and connecting
+#define DEFAULT_CONNECT_TIMEOUT 5000
+// Max # of events returned by a single epoll_wait()
+#define DEFAULT_CONNECT_EVENTS 64
+//-----------------------------
+
+// Includes
+//-----------------------------
+// Standard libraries
+#include <cerrno>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <unistd.h>
+// Socket / event libraries
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+#include "logger.h"
+#include "resolver.h"
+//-----------------------------
+
+// fd is a connected non-blocking socket owned by the receiver (see client_socket::c_adopt()),
+// or -1 with error set to an errno value (ETIMEDOUT, ECONNREFUSED, EHOSTUNREACH if the name didn't resolve, ...)
+struct connect_result
+{
+        int fd;
+        int error;
+};
+
+typedef std::function<void(int fd, int error)> connect_callback;
+
+// Not thread-safe: connect_to() and poll() belong to one thread, callbacks run inside poll()
+class connector
+{
+    private:
+        typedef std::chrono::steady_clock::time_point time_point;
+
+        struct pending_connect
+        {
+                std::string host;
+                int fd = -1;
+                time_point deadline;
+                connect_callback callback;
+                // Addresses are tried in order until one connects
+                std::vector<resolved_address> addresses;
+                size_t next = 0;
+                int error = 0;
+        };
+
+        // Lookups finish on resolver threads and are handed to poll() through here
+        struct resolved_inbox
+        {
+                struct resolution
+                {
+                        uint64_t id;
+                        int error;
+                        std::vector<resolved_address> addresses;
+                };
+                std::mutex lock;
+                std::vector<resolution> results;
+                int wakefd = -1;
+                bool closed = false;
+        };
+
+        resolver& names;
+        std::shared_ptr<resolved_inbox> inbox;
+        int epollfd = -1;
+        std::vector<struct epoll_event> events;
+
+        uint64_t next_id = 1;
+        std::unordered_map<uint64_t, pending_connect> requests;
+        // Earliest deadline first, entries of finished requests are skipped
+        std::priority_queue<std::pair<time_point, uint64_t>, std::vector<std::pair<time_point, uint64_t>>,
+                            std::greater<std::pair<time_point, uint64_t>>> deadlines;
+
+        void resolved(uint64_t id, int error, std::vector<resolved_address>& addresses);
+        void try_next(uint64_t id);
+        void finish(uint64_t id, int fd, int error);
+        void expire();
+        // Requests completed by the current poll()
+        int finished = 0;
+
+    public:
+        // Address family passed to the resolver (AF_UNSPEC tries IPv6 and IPv4 addresses in resolver order)
+        int c_domain = AF_UNSPEC;
+        // Connection type (e.g., TCP)
+        int c_type = SOCK_STREAM;
+        // Protocol (e.g., Internet Protocol)
+        int c_protocol = 0;
+
+        connector();
+        explicit connector(resolver& r);
+        ~connector();
+
+        connector(const connector&) = delete;
+        connector& operator=(const connector&) = delete;
+
+        // Create the epoll instance, 0 or -1
+        int init();
+
+        // Start connecting to host:port, callback runs from poll() once it connected, failed or timed out
+        // Returns a request id (never 0), or 0 if the connect couldn't be started (callback is not called)
+        uint64_t connect_to(const char* hostname, uint16_t port, int timeout, connect_callback callback);
+
+        // Same, the future becomes ready from poll()
+        std::future<connect_result> connect_to(const char* hostname, uint16_t port, int timeout = DEFAULT_CONNECT_TIMEOUT);
+
+        // Give up on a request, its callback is not called
+        void cancel(uint64_t id);
+
+        // Wait up to timeout ms (capped at the earliest deadline) and complete what is ready
+        // Returns the number of requests completed, or -1
+        int poll(int timeout);
+
+        // Requests still resolving or connecting
+        size_t pending();
+};
+
+#endif // connector.h
@@ -0,0 +1,294 @@
+//--------------------------
+// Datagram module
+//--------------------------
+// Description:
+// Batched UDP receive / send (recvmmsg / sendmmsg) into pooled buffers, with optional GSO / GRO
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#include "datagram.h"
+
+// Control space per receive slot (one int, the GRO segment size)
+#define DATAGRAM_CONTROL_SIZE CMSG_SPACE(sizeof(int))
+
+//-----------------------------
+// Class: datagram_batch
+//-----------------------------
+
+datagram_batch::~datagram_batch(){
+        release();
+}
+
+datagram_batch::datagram_batch(datagram_batch&& other) noexcept {
+        *this = std::move(other);
+}
+
+datagram_batch& datagram_batch::operator=(datagram_batch&& other) noexcept {
+        if (this != &other) {
+                release();
+                buffer = other.buffer;
+                capacity = other.capacity;
+                headers = std::move(other.headers);
+                iov = std::move(other.iov);
+                peers = std::move(other.peers);
+                control = std::move(other.control);
+                batch_size = other.batch_size;
+                slot_size = other.slot_size;
+
+                other.buffer = nullptr;
+                other.capacity = 0;
+        }
+        return *this;
+}
+
+// All slots in one lease, the arrays recvmmsg() works on are sized to match
+int datagram_batch::lease(){
+        if (batch_size == 0 || slot_size == 0) {
+                errno = EINVAL;
+                return -1;
+        }
+        buffer = buffer_pool::shared().acquire(batch_size * slot_size, capacity);
+        if (buffer == nullptr) {
+                errno = ENOMEM;
+                return -1;
+        }
+        headers.assign(batch_size, mmsghdr{});
+        iov.resize(batch_size);
+        peers.resize(batch_size);
+        control.assign(batch_size * DATAGRAM_CONTROL_SIZE, 0);
+        for (size_t i = 0; i < batch_size; i++) {
+                iov[i].iov_base = buffer + i * slot_size;
+                iov[i].iov_len = slot_size;
+        }
+        return 0;
+}
+
+void datagram_batch::release(){
+        buffer_pool::shared().release(buffer, capacity);
+        buffer = nullptr;
+        capacity = 0;
+}
+
+long datagram_batch::receive(int fd, std::vector<datagram>& datagrams){
+        if ( buffer == nullptr && lease() < 0 ) {
+                return -1;
+        }
+
+        // The kernel overwrites the lengths and flags, everything else stays set up from lease()
+        for (size_t i = 0; i < batch_size; i++) {
+                struct msghdr& msg = headers[i].msg_hdr;
+                msg.msg_name = &peers[i];
+                msg.msg_namelen = (socklen_t) sizeof(peers[i]);
+                msg.msg_iov = &iov[i];
+                msg.msg_iovlen = 1;
+                msg.msg_control = &control[i * DATAGRAM_CONTROL_SIZE];
+                msg.msg_controllen = DATAGRAM_CONTROL_SIZE;
+                msg.msg_flags = 0;
+        }
+
+        int n;
+        do {
+                n = recvmmsg(fd, headers.data(), (unsigned) batch_size, MSG_DONTWAIT, nullptr);
+        } while (n < 0 && errno == EINTR);
+        if (n < 0) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                        RSOCKET_COUNT(METRIC_READ_EAGAIN, 1);
+                }
+                return -1;
+        }
+
+        long appended = 0;
+        size_t num_bytes = 0;
+        for (int i = 0; i < n; i++) {
+                struct msghdr& msg = headers[i].msg_hdr;
+                size_t size = headers[i].msg_len;
+                num_bytes += size;
+
+                // A GRO receive is several datagrams of segment bytes back to back (the last may be shorter)
+                size_t segment = size;
+                for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+                        if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+                                int gso_size;
+                                std::memcpy(&gso_size, CMSG_DATA(cmsg), sizeof(gso_size));
+                                if (gso_size > 0) {
+                                        segment = (size_t) gso_size;
+                                }
+                        }
+                }
+
+                const char* data = (const char*) iov[i].iov_base;
+                size_t offset = 0;
+                do {
+                        datagram received;
+                        received.data = data + offset;
+                        received.size = std::min(segment, size - offset);
+                        std::memcpy(&received.peer, &peers[i], msg.msg_namelen);
+                        received.peer_len = msg.msg_namelen;
+                        received.truncated = (msg.msg_flags & MSG_TRUNC) != 0;
+                        datagrams.push_back(received);
+                        offset += received.size;
+                        appended++;
+                } while (offset < size);
+        }
+        RSOCKET_COUNT(METRIC_BYTES_IN, num_bytes);
+        RSOCKET_COUNT(METRIC_MESSAGES_IN, appended);
+        return appended;
+}
+
+//-----------------------------
+// Send helpers
+//-----------------------------
+
+int enable_gro(int fd){
+        int one = 1;
+        return setsockopt(fd, SOL_UDP, UDP_GRO, &one, sizeof(one));
+}
+
+static int wait_writable(int fd){
+        RSOCKET_COUNT(METRIC_WRITE_EAGAIN, 1);
+        struct pollfd pfd = {fd, POLLOUT, 0};
+        if ( poll(&pfd, 1, -1) < 0 && errno != EINTR ) {
+                return -1;
+        }
+        return 0;
+}
+
+long send_datagrams(int fd, const datagram* datagrams, size_t count){
+        struct mmsghdr headers[DATAGRAM_BATCH_SIZE];
+        struct iovec iov[DATAGRAM_BATCH_SIZE];
+        size_t sent = 0;
+
+        while (sent < count) {
+                size_t batch = std::min(count - sent, (size_t) DATAGRAM_BATCH_SIZE);
+                for (size_t i = 0; i < batch; i++) {
+                        const datagram& message = datagrams[sent + i];
+                        iov[i].iov_base = (void*) message.data;
+                        iov[i].iov_len = message.size;
+                        headers[i] = mmsghdr{};
+                        headers[i].msg_hdr.msg_iov = &iov[i];
+                        headers[i].msg_hdr.msg_iovlen = 1;
+                        if (message.peer_len != 0) {
+                                headers[i].msg_hdr.msg_name = (void*) &message.peer;
+                                headers[i].msg_hdr.msg_namelen = message.peer_len;
+                        }
+                }
+
+                int n;
+                do {
+                        n = sendmmsg(fd, headers, (unsigned) batch, MSG_NOSIGNAL | MSG_DONTWAIT);
+                } while (n < 0 && errno == EINTR);
+                if (n < 0) {
+                        if ( (errno == EAGAIN || errno == EWOULDBLOCK) && wait_writable(fd) == 0 ) {
+                                continue;
+                        }
+                        return sent > 0 ? (long) sent : -1;
+                }
+
+                size_t num_bytes = 0;
+                for (int i = 0; i < n; i++) {
+                        num_bytes += headers[i].msg_len;
+                }
+                RSOCKET_COUNT(METRIC_BYTES_OUT, num_bytes);
+                RSOCKET_COUNT(METRIC_MESSAGES_OUT, n);
+                sent += (size_t) n;
+        }
+        return (long) sent;
+}
+
+// One sendmsg() carrying a UDP_SEGMENT cmsg, returns bytes sent, 0 on EAGAIN, -1 on error
+static long send_gso_once(int fd, const char* data, size_t length, uint16_t segment_size,
+                          const struct sockaddr* peer, socklen_t peer_len){
+        char control[CMSG_SPACE(sizeof(uint16_t))] = {};
+        struct iovec iov = {(void*) data, length};
+        struct msghdr msg = {};
+        msg.msg_name = (void*) peer;
+        msg.msg_namelen = peer_len;
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+
+        struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_UDP;
+        cmsg->cmsg_type = UDP_SEGMENT;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+        std::memcpy(CMSG_DATA(cmsg), &segment_size, sizeof(segment_size));
+
+        long num_bytes;
+        do {
+                num_bytes = (long) sendmsg(fd, &msg, MSG_NOSIGNAL | MSG_DONTWAIT);
+        } while (num_bytes < 0 && errno == EINTR);
+        if (num_bytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                return 0;
+        }
+        return num_bytes;
+}
+
+long send_segments(int fd, const char* data, size_t length, size_t segment_size,
+                   const struct sockaddr* peer, socklen_t peer_len){
+        if (segment_size == 0 || segment_size > UINT16_MAX) {
+                errno = EINVAL;
+                return -1;
+        }
+        size_t per_send = std::min((size_t) DATAGRAM_GSO_MAX_SEGMENTS, DATAGRAM_GSO_MAX_BYTES / segment_size);
+        if (per_send == 0) {
+                per_send = 1;
+        }
+        // Tried until the kernel turns it down once
+        bool gso = per_send > 1;
+
+        long sent = 0;
+        size_t offset = 0;
+        while (offset < length) {
+                size_t chunk = std::min(length - offset, per_send * segment_size);
+                size_t segments = (chunk + segment_size - 1) / segment_size;
+
+                if (gso && segments > 1) {
+                        long num_bytes = send_gso_once(fd, data + offset, chunk, (uint16_t) segment_size, peer, peer_len);
+                        if (num_bytes > 0) {
+                                RSOCKET_COUNT(METRIC_BYTES_OUT, num_bytes);
+                                RSOCKET_COUNT(METRIC_MESSAGES_OUT, segments);
+                                sent += (long) segments;
+                                offset += chunk;
+                                continue;
+                        }
+                        if (num_bytes == 0) {
+                                if ( wait_writable(fd) < 0 ) {
+                                        return sent > 0 ? sent : -1;
+                                }
+                                continue;
+                        }
+                        // No GSO in this kernel / for this route (EIO: device can't checksum), send them one by one
+                        if (errno != EINVAL && errno != EIO && errno != ENOPROTOOPT && errno != EOPNOTSUPP) {
+                                return sent > 0 ? sent : -1;
+                        }
+                        gso = false;
+                }
+
+                datagram batch[DATAGRAM_GSO_MAX_SEGMENTS];
+                for (size_t i = 0; i < segments; i++) {
+                        batch[i].data = data + offset + i * segment_size;
+                        batch[i].size = std::min(segment_size, chunk - i * segment_size);
+                        if (peer != nullptr) {
+                                std::memcpy(&batch[i].peer, peer, peer_len);
+                                batch[i].peer_len = peer_len;
+                        }
+                }
+                long n = send_datagrams(fd, batch, segments);
+                if (n < 0) {
+                        return sent > 0 ? sent : -1;
+                }
+                sent += n;
+                if ( (size_t) n < segments ) {
+                        return sent;
+                }
+                offset += chunk;
+        }
+        return sent;
+}
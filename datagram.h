@@ -0,0 +1,116 @@
+//--------------------------
+// Datagram module header
+//--------------------------
+// Description:
+// Batched UDP receive / send (recvmmsg / sendmmsg) into pooled buffers, with optional GSO / GRO
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#ifndef _datagram_H_INCLUDED
+#define _datagram_H_INCLUDED
+
+// Default settings
+//-----------------------------
+// Datagrams moved by one recvmmsg() / sendmmsg()
+#define DATAGRAM_BATCH_SIZE 64
+// Receive slot size, longer datagrams are cut off (and flagged truncated)
+#define DATAGRAM_SLOT_SIZE 2048
+// Slots / slot size once GRO is enabled, the kernel hands over up to 64 KB of coalesced datagrams per slot
+#define DATAGRAM_GRO_BATCH_SIZE 16
+#define DATAGRAM_GRO_SLOT_SIZE (64 * 1024)
+// Most datagrams / payload bytes handed to the kernel in one UDP_SEGMENT send
+#define DATAGRAM_GSO_MAX_SEGMENTS 64
+#define DATAGRAM_GSO_MAX_BYTES 65000
+//-----------------------------
+
+// Includes
+//-----------------------------
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+
+#include "buffer_pool.h"
+#include "metrics.h"
+//-----------------------------
+
+struct datagram
+{
+        // Payload. Received datagrams point into the datagram_batch, valid until its next receive()
+        const char* data = nullptr;
+        size_t size = 0;
+        // Sender of a received datagram / destination of a sent one, peer_len 0 = the connected peer
+        struct sockaddr_storage peer;
+        socklen_t peer_len = 0;
+        // Received datagram was larger than the slot, data holds only the first slot size bytes
+        bool truncated = false;
+};
+
+// Receive side of a datagram socket: slot memory for batch_size datagrams in one pooled lease, plus the
+// mmsghdr / iovec / address / control arrays recvmmsg() fills, all reused from call to call
+// The lease is taken on the first receive(), change batch_size / slot_size before that (or after release())
+class datagram_batch
+{
+    private:
+        char* buffer = nullptr;
+        size_t capacity = 0;
+        std::vector<struct mmsghdr> headers;
+        std::vector<struct iovec> iov;
+        std::vector<struct sockaddr_storage> peers;
+        // One cmsg per slot, carries the GRO segment size
+        std::vector<char> control;
+
+        int lease();
+
+    public:
+        size_t batch_size = DATAGRAM_BATCH_SIZE;
+        size_t slot_size = DATAGRAM_SLOT_SIZE;
+
+        datagram_batch() = default;
+        ~datagram_batch();
+
+        datagram_batch(const datagram_batch&) = delete;
+        datagram_batch& operator=(const datagram_batch&) = delete;
+        datagram_batch(datagram_batch&& other) noexcept;
+        datagram_batch& operator=(datagram_batch&& other) noexcept;
+
+        // Receive up to batch_size datagrams with a single non-blocking recvmmsg() and append them to datagrams,
+        // GRO slots are split back into the datagrams the sender sent
+        // Returns the number appended, or -1 (EAGAIN if nothing was pending)
+        long receive(int fd, std::vector<datagram>& datagrams);
+
+        // Give the slot memory back to the pool (views from receive() become invalid)
+        void release();
+};
+
+// Let the kernel coalesce consecutive datagrams from one sender into one receive (UDP_GRO, Linux 5.0+)
+// Use the DATAGRAM_GRO_* batch settings, a coalesced receive doesn't fit a DATAGRAM_SLOT_SIZE slot
+int enable_gro(int fd);
+
+// Send count datagrams with as few sendmmsg() calls as possible
+// EINTR is retried and EAGAIN waits for writability like send_iov_all(), SIGPIPE is suppressed
+// Returns the number sent, or -1 if the first one failed (a later failure returns the count before it)
+long send_datagrams(int fd, const datagram* datagrams, size_t count);
+
+// Send length bytes as datagrams of segment_size bytes (the last one may be shorter) to peer (nullptr = connected peer)
+// Up to DATAGRAM_GSO_MAX_SEGMENTS datagrams go down the stack as one buffer (UDP_SEGMENT, Linux 4.18+) and are
+// split by the kernel or the NIC. Without GSO support they are sent with send_datagrams() batches
+// Returns the number of datagrams sent or -1
+long send_segments(int fd, const char* data, size_t length, size_t segment_size,
+                   const struct sockaddr* peer = nullptr, socklen_t peer_len = 0);
+
+#endif // datagram.h
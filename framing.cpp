@@ -0,0 +1,71 @@
+//--------------------------
+// Framing module
+//--------------------------
+// Description:
+// Message framing shared by client_socket and server_socket
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#include "framing.h"
+#include "scan.h"
+
+// Delimiter offsets collected per scan_delimiters() call
+#define SCAN_BATCH 256
+
+size_t split_fields(const frame_view& message, std::vector<frame_view>& fields, char separator){
+        fields.clear();
+
+        const char* start = message.data;
+        const char* end = message.data + message.size;
+        while (true) {
+                const char* found = (const char*) std::memchr(start, separator, (size_t) (end - start));
+                if (found == nullptr) {
+                        fields.push_back(frame_view{start, (size_t) (end - start)});
+                        break;
+                }
+                fields.push_back(frame_view{start, (size_t) (found - start)});
+                start = found + 1;
+        }
+        return fields.size();
+}
+
+size_t split_block(const frame_view& block, std::vector<frame_view>& fields, std::vector<size_t>& message_ends){
+        fields.clear();
+        message_ends.clear();
+
+        uint32_t offsets[SCAN_BATCH];
+        size_t field_start = 0;
+        size_t consumed = 0;
+        size_t position = 0;
+        while (position < block.size) {
+                size_t found = scan_delimiters(block.data + position, block.size - position, offsets, SCAN_BATCH);
+                for (size_t i = 0; i < found; i++) {
+                        size_t offset = position + offsets[i];
+                        char delimiter = block.data[offset];
+                        if (delimiter == '\0') {
+                                // End of data, anything after the last '!' is incomplete
+                                fields.resize(message_ends.empty() ? 0 : message_ends.back());
+                                return consumed;
+                        }
+                        fields.push_back(frame_view{block.data + field_start, offset - field_start});
+                        field_start = offset + 1;
+                        if (delimiter == '!') {
+                                message_ends.push_back(fields.size());
+                                consumed = field_start;
+                        }
+                }
+                if (found < SCAN_BATCH) {
+                        break;
+                }
+                position += (size_t) offsets[SCAN_BATCH - 1] + 1;
+        }
+
+        fields.resize(message_ends.empty() ? 0 : message_ends.back());
+        return consumed;
+}
@@ -0,0 +1,106 @@
+//--------------------------
+// Framing module header
+//--------------------------
+// Description:
+// Message framing shared by client_socket and server_socket
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#ifndef _framing_H_INCLUDED
+#define _framing_H_INCLUDED
+
+// Default settings
+//-----------------------------
+// Size of the binary length header (big-endian u32)
+#define FRAME_HEADER_SIZE 4
+// Sent once by a client to switch a FRAMING_AUTO server connection to length-prefixed framing
+// Starts with NUL, which never begins a delimited message
+#define FRAME_PREAMBLE "\0RSB"
+#define FRAME_PREAMBLE_SIZE 4
+// Default field separator inside a message
+#define DEFAULT_FIELD_SEPARATOR ','
+// Size of the correlation id (big-endian u64) at the start of every RPC request / reply payload
+#define RPC_ID_SIZE 8
+//-----------------------------
+
+// Includes
+//-----------------------------
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+//-----------------------------
+
+// Non-owning view of a message or field inside a receive buffer
+// Valid only as long as the buffer it points into is left untouched (e.g., until the next recv_buffer::fill())
+struct frame_view
+{
+        const char* data;
+        size_t size;
+};
+
+enum framing_mode
+{
+        // Messages end with '!', payloads cannot contain '!' or NUL
+        FRAMING_DELIMITED = 0,
+        // Messages start with a FRAME_HEADER_SIZE byte length, payloads may be arbitrary binary
+        FRAMING_LENGTH_PREFIXED = 1,
+        // Server side only: length-prefixed if the connection opens with FRAME_PREAMBLE, delimited otherwise
+        FRAMING_AUTO = 2
+};
+
+// Write length as a big-endian u32 into header[0..3]
+inline void encode_frame_header(uint32_t length, char* header){
+        header[0] = (char) (length >> 24);
+        header[1] = (char) (length >> 16);
+        header[2] = (char) (length >> 8);
+        header[3] = (char) length;
+}
+
+// Read a big-endian u32 length from header[0..3]
+inline uint32_t decode_frame_header(const char* header){
+        const unsigned char* h = (const unsigned char*) header;
+        return ((uint32_t) h[0] << 24) | ((uint32_t) h[1] << 16) | ((uint32_t) h[2] << 8) | (uint32_t) h[3];
+}
+
+// Write an RPC correlation id as a big-endian u64 into out[0..7]
+inline void encode_rpc_id(uint64_t id, char* out){
+        for (int i = 0; i < RPC_ID_SIZE; i++) {
+                out[i] = (char) (id >> (56 - 8 * i));
+        }
+}
+
+// Split a length-prefixed RPC message into its correlation id and body
+// Returns false if the message is too short to carry an id
+inline bool split_rpc_frame(const frame_view& message, uint64_t& id, frame_view& body){
+        if (message.size < RPC_ID_SIZE) {
+                return false;
+        }
+        const unsigned char* p = (const unsigned char*) message.data;
+        id = 0;
+        for (int i = 0; i < RPC_ID_SIZE; i++) {
+                id = (id << 8) | p[i];
+        }
+        body.data = message.data + RPC_ID_SIZE;
+        body.size = message.size - RPC_ID_SIZE;
+        return true;
+}
+
+// Split a message into separator delimited fields, without copying or allocating
+// fields is cleared and reused, so it only allocates until it has grown to the largest field count seen
+// Returns the number of fields
+size_t split_fields(const frame_view& message, std::vector<frame_view>& fields, char separator = DEFAULT_FIELD_SEPARATOR);
+
+// Split every complete '!' terminated message in block into its comma delimited fields in one pass
+// fields receives the fields of all messages back to back, message_ends[i] is one past the last field of message i
+// Both vectors are cleared and reused. Scanning stops at '\0'
+// Returns the number of bytes consumed (up to and including the last '!'), the rest is an incomplete message
+size_t split_block(const frame_view& block, std::vector<frame_view>& fields, std::vector<size_t>& message_ends);
+
+#endif // framing.h
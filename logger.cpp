@@ -0,0 +1,237 @@
+//--------------------------
+// Logger module
+//--------------------------
+// Description:
+// Leveled, asynchronous logging for the socket library
+// Callers format into a lock-free queue, a background thread adds timestamps and writes to stdout
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#include "logger.h"
+
+#include <cerrno>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+// How long the writer sleeps when the queue is empty
+#define LOG_IDLE_SLEEP_US 1000
+
+std::atomic<int> log_runtime_level(DEFAULT_LOG_LEVEL);
+
+static const char* level_names[] = {"ERROR", "WARN ", "INFO ", "DEBUG", "TRACE"};
+
+struct log_cell
+{
+        std::atomic<size_t> sequence;
+        int level;
+        struct timespec time;
+        char text[LOG_MESSAGE_SIZE];
+};
+
+//-----------------------------
+// Class: log_queue
+//-----------------------------
+// Bounded multi-producer / single-consumer queue (per-cell sequence numbers, no locks)
+// Drained by one writer thread that owns all formatting of timestamps and the actual output
+//-----------------------------
+class log_queue
+{
+    private:
+        log_cell cells[LOG_QUEUE_SIZE];
+        alignas(64) std::atomic<size_t> enqueue_pos;
+        alignas(64) std::atomic<size_t> dequeue_pos;
+        std::atomic<uint64_t> dropped;
+        std::atomic<bool> stopping;
+        std::atomic<bool> stopped;
+        std::once_flag start_once;
+        std::thread writer;
+
+        // Timestamp cache, only touched by whoever is writing
+        time_t cached_second = -1;
+        char cached_stamp[32];
+
+        void run();
+        size_t drain();
+        void write_line(int level, const struct timespec& time, const char* text);
+
+    public:
+        log_queue();
+
+        void start();
+        void stop();
+        void push(int level, const char* format, va_list args);
+        void flush();
+        uint64_t dropped_count();
+};
+
+log_queue::log_queue() : enqueue_pos(0), dequeue_pos(0), dropped(0), stopping(false), stopped(false) {
+        for (size_t i = 0; i < LOG_QUEUE_SIZE; i++) {
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+}
+
+static log_queue& queue(){
+        // Never destroyed, so logging from other static destructors stays safe
+        static log_queue* q = new log_queue();
+        return *q;
+}
+
+static void stop_queue(){
+        queue().stop();
+}
+
+void log_queue::start(){
+        std::call_once(start_once, [this]() {
+                writer = std::thread(&log_queue::run, this);
+                // Drain whatever is left at exit
+                atexit(stop_queue);
+        });
+}
+
+void log_queue::stop(){
+        stopping = true;
+        if (writer.joinable()) {
+                writer.join();
+        }
+        stopped = true;
+}
+
+void log_queue::push(int level, const char* format, va_list args){
+        if (stopped) {
+                // Writer is gone (process exiting), write synchronously
+                char text[LOG_MESSAGE_SIZE];
+                vsnprintf(text, sizeof(text), format, args);
+                struct timespec now;
+                clock_gettime(CLOCK_REALTIME_COARSE, &now);
+                write_line(level, now, text);
+                fflush(stdout);
+                return;
+        }
+
+        // Claim a cell
+        size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+        log_cell* cell;
+        while (true) {
+                cell = &cells[pos & (LOG_QUEUE_SIZE - 1)];
+                size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                intptr_t diff = (intptr_t) sequence - (intptr_t) pos;
+                if (diff == 0) {
+                        if ( enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed) ) {
+                                break;
+                        }
+                } else if (diff < 0) {
+                        // Queue full, never block the caller
+                        dropped.fetch_add(1, std::memory_order_relaxed);
+                        return;
+                } else {
+                        pos = enqueue_pos.load(std::memory_order_relaxed);
+                }
+        }
+
+        cell->level = level;
+        clock_gettime(CLOCK_REALTIME_COARSE, &cell->time);
+        vsnprintf(cell->text, LOG_MESSAGE_SIZE, format, args);
+        // Publish to the writer
+        cell->sequence.store(pos + 1, std::memory_order_release);
+}
+
+void log_queue::write_line(int level, const struct timespec& time, const char* text){
+        // Only reformat the date once per second
+        if (time.tv_sec != cached_second) {
+                struct tm local;
+                localtime_r(&time.tv_sec, &local);
+                strftime(cached_stamp, sizeof(cached_stamp), "%Y-%m-%d %H:%M:%S", &local);
+                cached_second = time.tv_sec;
+        }
+        if (level < LOG_LEVEL_ERROR || level > LOG_LEVEL_TRACE) {
+                level = LOG_LEVEL_INFO;
+        }
+        fprintf(stdout, "[%s.%03ld] %s %s\n", cached_stamp, time.tv_nsec / 1000000, level_names[level], text);
+}
+
+// Write out everything currently queued, returns number of messages written
+size_t log_queue::drain(){
+        size_t written = 0;
+        size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+        while (true) {
+                log_cell* cell = &cells[pos & (LOG_QUEUE_SIZE - 1)];
+                if (cell->sequence.load(std::memory_order_acquire) != pos + 1) {
+                        break;
+                }
+                write_line(cell->level, cell->time, cell->text);
+                // Hand the cell back to producers
+                cell->sequence.store(pos + LOG_QUEUE_SIZE, std::memory_order_release);
+                pos++;
+                written++;
+        }
+        if (written > 0) {
+                // One flush per batch instead of one per line
+                fflush(stdout);
+                dequeue_pos.store(pos, std::memory_order_release);
+        }
+        return written;
+}
+
+void log_queue::run(){
+        while (true) {
+                if (drain() == 0) {
+                        if (stopping) {
+                                break;
+                        }
+                        std::this_thread::sleep_for(std::chrono::microseconds(LOG_IDLE_SLEEP_US));
+                }
+        }
+}
+
+void log_queue::flush(){
+        if (stopped || !writer.joinable()) {
+                return;
+        }
+        size_t target = enqueue_pos.load(std::memory_order_acquire);
+        while (dequeue_pos.load(std::memory_order_acquire) < target) {
+                std::this_thread::sleep_for(std::chrono::microseconds(LOG_IDLE_SLEEP_US / 10));
+        }
+}
+
+uint64_t log_queue::dropped_count(){
+        return dropped.load(std::memory_order_relaxed);
+}
+
+//-----------------------------
+
+void log_set_level(int level){
+        log_runtime_level.store(level, std::memory_order_relaxed);
+}
+
+void log_write(int level, const char* format, ...){
+        // Callers log on error paths and then return, errno must survive
+        int errsv = errno;
+        log_queue& q = queue();
+        q.start();
+
+        va_list args;
+        va_start(args, format);
+        q.push(level, format, args);
+        va_end(args);
+        errno = errsv;
+}
+
+void log_flush(){
+        queue().flush();
+}
+
+uint64_t log_dropped(){
+        return queue().dropped_count();
+}
@@ -0,0 +1,106 @@
+//--------------------------
+// Logger module header
+//--------------------------
+// Description:
+// Leveled, asynchronous logging for the socket library
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#ifndef _logger_H_INCLUDED
+#define _logger_H_INCLUDED
+
+// Log levels
+//-----------------------------
+#define LOG_LEVEL_NONE -1
+#define LOG_LEVEL_ERROR 0
+#define LOG_LEVEL_WARN 1
+#define LOG_LEVEL_INFO 2
+#define LOG_LEVEL_DEBUG 3
+// Payload dumps and per-message tracing
+#define LOG_LEVEL_TRACE 4
+//-----------------------------
+
+// Default settings
+//-----------------------------
+// Most verbose level compiled in, anything above it compiles to nothing
+// Override with -DRSOCKET_LOG_LEVEL=...
+#ifndef RSOCKET_LOG_LEVEL
+#ifdef NDEBUG
+#define RSOCKET_LOG_LEVEL LOG_LEVEL_INFO
+#else
+#define RSOCKET_LOG_LEVEL LOG_LEVEL_TRACE
+#endif
+#endif
+// Default runtime level
+#define DEFAULT_LOG_LEVEL LOG_LEVEL_INFO
+// Max length of one formatted log message (longer messages are truncated)
+#define LOG_MESSAGE_SIZE 256
+// Number of messages the queue can hold before new messages are dropped (power of 2)
+#define LOG_QUEUE_SIZE 4096
+//-----------------------------
+
+// Includes
+//-----------------------------
+#include <atomic>
+#include <cstdint>
+//-----------------------------
+
+// Runtime level, messages above it are discarded before formatting
+extern std::atomic<int> log_runtime_level;
+
+inline bool log_enabled(int level){
+        return level <= log_runtime_level.load(std::memory_order_relaxed);
+}
+
+void log_set_level(int level);
+
+// Format a message and queue it for the background writer thread
+// Never blocks: if the queue is full the message is dropped and counted
+void log_write(int level, const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+// Block until everything queued so far has been written
+void log_flush();
+
+// Number of messages dropped because the queue was full
+uint64_t log_dropped();
+
+#define RSOCKET_LOG(level, ...) \
+        do { if ( log_enabled(level) ) { log_write(level, __VA_ARGS__); } } while (0)
+
+#if RSOCKET_LOG_LEVEL >= LOG_LEVEL_ERROR
+#define RSOCKET_LOG_ERROR(...) RSOCKET_LOG(LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define RSOCKET_LOG_ERROR(...) do {} while (0)
+#endif
+
+#if RSOCKET_LOG_LEVEL >= LOG_LEVEL_WARN
+#define RSOCKET_LOG_WARN(...) RSOCKET_LOG(LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+#define RSOCKET_LOG_WARN(...) do {} while (0)
+#endif
+
+#if RSOCKET_LOG_LEVEL >= LOG_LEVEL_INFO
+#define RSOCKET_LOG_INFO(...) RSOCKET_LOG(LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define RSOCKET_LOG_INFO(...) do {} while (0)
+#endif
+
+#if RSOCKET_LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define RSOCKET_LOG_DEBUG(...) RSOCKET_LOG(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define RSOCKET_LOG_DEBUG(...) do {} while (0)
+#endif
+
+#if RSOCKET_LOG_LEVEL >= LOG_LEVEL_TRACE
+#define RSOCKET_LOG_TRACE(...) RSOCKET_LOG(LOG_LEVEL_TRACE, __VA_ARGS__)
+#else
+#define RSOCKET_LOG_TRACE(...) do {} while (0)
+#endif
+
+#endif // logger.h
@@ -0,0 +1,198 @@
+//--------------------------
+// Metrics module
+//--------------------------
+// Description:
+// Per-thread counters and latency histograms for the socket library, with a snapshot API
+// and a Prometheus text dump
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#include "metrics.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+const char* counter_names[METRIC_COUNTER_COUNT] = {
+        "accepts_total",
+        "accept_errors_total",
+        "closes_total",
+        "bytes_in_total",
+        "bytes_out_total",
+        "messages_in_total",
+        "messages_out_total",
+        "partial_reads_total",
+        "read_eagain_total",
+        "write_eagain_total",
+        "queued_bytes",
+        "loop_iterations_total",
+        "timeouts_total",
+};
+
+const char* counter_help[METRIC_COUNTER_COUNT] = {
+        "Client connections accepted",
+        "Failed accept attempts (not counting an empty backlog)",
+        "Client connections removed",
+        "Bytes received",
+        "Bytes sent",
+        "Messages parsed from received data",
+        "Messages sent or queued",
+        "Reads that left part of a message buffered",
+        "Reads that found nothing to read",
+        "Sends that found the socket buffer full",
+        "Bytes waiting in send queues",
+        "Event loop iterations (s_poll calls)",
+        "Clients timed out (idle, read / write deadline)",
+};
+
+const char* histogram_names[METRIC_HISTOGRAM_COUNT] = {
+        "loop_iteration_seconds",
+        "ready_to_handler_seconds",
+};
+
+const char* histogram_help[METRIC_HISTOGRAM_COUNT] = {
+        "Time spent handling events between two s_poll calls",
+        "Time from a client becoming readable to its data being read",
+};
+
+// Live threads, plus everything threads that exited had counted
+struct registry
+{
+        std::mutex lock;
+        std::vector<thread_metrics*> threads;
+        metrics_snapshot retired = {};
+};
+
+// Leaked so threads exiting after main() can still fold their counts in
+registry& metrics_registry(){
+        static registry* shared = new registry();
+        return *shared;
+}
+
+void add_thread(const thread_metrics& local, metrics_snapshot& snapshot){
+        for (int i = 0; i < METRIC_COUNTER_COUNT; i++) {
+                snapshot.counters[i] += local.counters[i].load(std::memory_order_relaxed);
+        }
+        for (int h = 0; h < METRIC_HISTOGRAM_COUNT; h++) {
+                histogram_snapshot& histogram = snapshot.histograms[h];
+                for (int b = 0; b < METRIC_HISTOGRAM_BUCKETS; b++) {
+                        uint64_t count = local.buckets[h][b].load(std::memory_order_relaxed);
+                        histogram.buckets[b] += count;
+                        histogram.count += count;
+                }
+                histogram.sum += local.sums[h].load(std::memory_order_relaxed);
+        }
+}
+
+// Owns the calling thread's block, folds it into the retired totals on thread exit
+struct thread_slot
+{
+        thread_metrics metrics = {};
+
+        thread_slot() {
+                registry& shared = metrics_registry();
+                std::lock_guard<std::mutex> guard(shared.lock);
+                shared.threads.push_back(&metrics);
+        }
+
+        ~thread_slot() {
+                registry& shared = metrics_registry();
+                std::lock_guard<std::mutex> guard(shared.lock);
+                add_thread(metrics, shared.retired);
+                for (size_t i = 0; i < shared.threads.size(); i++) {
+                        if (shared.threads[i] == &metrics) {
+                                shared.threads[i] = shared.threads.back();
+                                shared.threads.pop_back();
+                                break;
+                        }
+                }
+        }
+};
+
+// Plain pointer for the fast path, the slot object itself needs a guarded thread_local
+thread_local thread_metrics* current = nullptr;
+
+} // namespace
+
+thread_metrics& metrics_local(){
+        if (current == nullptr) {
+                thread_local thread_slot slot;
+                current = &slot.metrics;
+        }
+        return *current;
+}
+
+void metrics_collect(metrics_snapshot& snapshot){
+        registry& shared = metrics_registry();
+        std::lock_guard<std::mutex> guard(shared.lock);
+        snapshot = shared.retired;
+        for (thread_metrics* local : shared.threads) {
+                add_thread(*local, snapshot);
+        }
+}
+
+uint64_t histogram_snapshot::quantile(double q) const {
+        if (count == 0) {
+                return 0;
+        }
+        uint64_t rank = (uint64_t) (q * (double) count);
+        if (rank >= count) {
+                rank = count - 1;
+        }
+        uint64_t seen = 0;
+        for (int b = 0; b < METRIC_HISTOGRAM_BUCKETS; b++) {
+                seen += buckets[b];
+                if (seen > rank) {
+                        return (uint64_t) 1 << b;
+                }
+        }
+        return (uint64_t) 1 << (METRIC_HISTOGRAM_BUCKETS - 1);
+}
+
+std::string metrics_prometheus(){
+        metrics_snapshot snapshot;
+        metrics_collect(snapshot);
+
+        std::string out;
+        char line[256];
+        for (int i = 0; i < METRIC_COUNTER_COUNT; i++) {
+                const char* type = (i == METRIC_QUEUED_BYTES) ? "gauge" : "counter";
+                snprintf(line, sizeof(line), "# HELP rsocket_%s %s\n# TYPE rsocket_%s %s\nrsocket_%s %" PRId64 "\n",
+                         counter_names[i], counter_help[i], counter_names[i], type, counter_names[i], snapshot.counters[i]);
+                out += line;
+        }
+        for (int h = 0; h < METRIC_HISTOGRAM_COUNT; h++) {
+                const histogram_snapshot& histogram = snapshot.histograms[h];
+                const char* name = histogram_names[h];
+                snprintf(line, sizeof(line), "# HELP rsocket_%s %s\n# TYPE rsocket_%s histogram\n", name, histogram_help[h], name);
+                out += line;
+                uint64_t cumulative = 0;
+                // The last bucket is open ended, it only shows up in +Inf
+                for (int b = 0; b < METRIC_HISTOGRAM_BUCKETS - 1; b++) {
+                        cumulative += histogram.buckets[b];
+                        snprintf(line, sizeof(line), "rsocket_%s_bucket{le=\"%.6f\"} %" PRIu64 "\n", name, (double) ((uint64_t) 1 << b) / 1e6, cumulative);
+                        out += line;
+                }
+                snprintf(line, sizeof(line), "rsocket_%s_bucket{le=\"+Inf\"} %" PRIu64 "\nrsocket_%s_sum %.6f\nrsocket_%s_count %" PRIu64 "\n",
+                         name, histogram.count, name, (double) histogram.sum / 1e6, name, histogram.count);
+                out += line;
+        }
+        return out;
+}
+
+const char* metric_name(metric_counter counter){
+        return counter_names[counter];
+}
+
+const char* metric_name(metric_histogram histogram){
+        return histogram_names[histogram];
+}
@@ -0,0 +1,138 @@
+//--------------------------
+// Metrics module header
+//--------------------------
+// Description:
+// Per-thread counters and latency histograms for the socket library, with a snapshot API
+// and a Prometheus text dump
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#ifndef _metrics_H_INCLUDED
+#define _metrics_H_INCLUDED
+
+// Default settings
+//-----------------------------
+// Compile the instrumentation in (1) or out (0), override with -DRSOCKET_METRICS=0 (CMake option RSOCKET_METRICS)
+#ifndef RSOCKET_METRICS
+#define RSOCKET_METRICS 1
+#endif
+// Histogram buckets, bucket i counts values below 2^i microseconds (the last one everything else)
+#define METRIC_HISTOGRAM_BUCKETS 32
+//-----------------------------
+
+// Includes
+//-----------------------------
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <time.h>
+//-----------------------------
+
+enum metric_counter
+{
+        METRIC_ACCEPTS,
+        METRIC_ACCEPT_ERRORS,
+        METRIC_CLOSES,
+        METRIC_BYTES_IN,
+        METRIC_BYTES_OUT,
+        METRIC_MESSAGES_IN,
+        METRIC_MESSAGES_OUT,
+        // next_frame() found only part of a message, the rest is still on its way
+        METRIC_PARTIAL_READS,
+        METRIC_READ_EAGAIN,
+        // Sends that found the socket buffer full (the data was queued or waited for)
+        METRIC_WRITE_EAGAIN,
+        // Gauge: bytes waiting in send queues
+        METRIC_QUEUED_BYTES,
+        METRIC_LOOP_ITERATIONS,
+        // Clients cut off by an idle timeout or a read / write deadline
+        METRIC_TIMEOUTS,
+        METRIC_COUNTER_COUNT
+};
+
+enum metric_histogram
+{
+        // Time the caller spent between two s_poll() calls (handling what the last one returned)
+        METRIC_LOOP_ITERATION_US,
+        // Time from a client becoming readable to its data being read
+        METRIC_READY_TO_HANDLER_US,
+        METRIC_HISTOGRAM_COUNT
+};
+
+struct histogram_snapshot
+{
+        uint64_t buckets[METRIC_HISTOGRAM_BUCKETS];
+        uint64_t count;
+        // Sum of all observed values (microseconds)
+        uint64_t sum;
+
+        // Upper bound (microseconds) of the bucket holding quantile q (0..1), 0 if empty
+        uint64_t quantile(double q) const;
+};
+
+struct metrics_snapshot
+{
+        int64_t counters[METRIC_COUNTER_COUNT];
+        histogram_snapshot histograms[METRIC_HISTOGRAM_COUNT];
+};
+
+// One thread's counters, only that thread writes them so updates are plain relaxed load / store
+struct thread_metrics
+{
+        std::atomic<int64_t> counters[METRIC_COUNTER_COUNT];
+        std::atomic<uint64_t> buckets[METRIC_HISTOGRAM_COUNT][METRIC_HISTOGRAM_BUCKETS];
+        std::atomic<uint64_t> sums[METRIC_HISTOGRAM_COUNT];
+};
+
+// Block of the calling thread, registered on first use and folded into the totals when the thread exits
+thread_metrics& metrics_local();
+
+inline void metrics_add(metric_counter counter, int64_t n){
+        std::atomic<int64_t>& value = metrics_local().counters[counter];
+        value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+inline unsigned metrics_bucket(uint64_t value){
+        unsigned bucket = (value == 0) ? 0 : 64 - (unsigned) __builtin_clzll(value);
+        return bucket < METRIC_HISTOGRAM_BUCKETS ? bucket : METRIC_HISTOGRAM_BUCKETS - 1;
+}
+
+inline void metrics_observe(metric_histogram histogram, uint64_t value){
+        thread_metrics& local = metrics_local();
+        std::atomic<uint64_t>& bucket = local.buckets[histogram][metrics_bucket(value)];
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        local.sums[histogram].store(local.sums[histogram].load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+// Monotonic clock in microseconds, for histogram observations
+inline uint64_t metrics_now_us(){
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return (uint64_t) now.tv_sec * 1000000 + (uint64_t) now.tv_nsec / 1000;
+}
+
+// Sum every thread's counters (live and exited) into snapshot, safe from any thread
+// Counters of running threads may be a few updates behind
+void metrics_collect(metrics_snapshot& snapshot);
+
+// Snapshot in Prometheus text exposition format, metric names prefixed with rsocket_
+std::string metrics_prometheus();
+
+const char* metric_name(metric_counter counter);
+const char* metric_name(metric_histogram histogram);
+
+#if RSOCKET_METRICS
+#define RSOCKET_COUNT(counter, n) metrics_add(counter, (int64_t) (n))
+#define RSOCKET_OBSERVE(histogram, value) metrics_observe(histogram, (uint64_t) (value))
+#else
+#define RSOCKET_COUNT(counter, n) do {} while (0)
+#define RSOCKET_OBSERVE(histogram, value) do {} while (0)
+#endif
+
+#endif // metrics.h
@@ -0,0 +1,265 @@
+//--------------------------
+// Receive buffer module
+//--------------------------
+// Description:
+// Per-connection receive buffer with incremental message framing
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#include "recv_buffer.h"
+
+//-----------------------------
+// Class: recv_buffer
+//-----------------------------
+
+recv_buffer::recv_buffer() : recv_buffer(DEFAULT_RECV_BUFFER_SIZE, DEFAULT_MAX_RECV_BUFFER_SIZE) {
+}
+
+recv_buffer::recv_buffer(size_t i_c, size_t m_c){
+        initial_capacity = i_c;
+        max_capacity = m_c;
+}
+
+recv_buffer::~recv_buffer(){
+        buffer_pool::shared().release(buffer, capacity);
+}
+
+recv_buffer::recv_buffer(recv_buffer&& other) noexcept {
+        *this = std::move(other);
+}
+
+recv_buffer& recv_buffer::operator=(recv_buffer&& other) noexcept {
+        if (this != &other) {
+                buffer_pool::shared().release(buffer, capacity);
+                buffer = other.buffer;
+                capacity = other.capacity;
+                head = other.head;
+                tail = other.tail;
+                scan = other.scan;
+                initial_capacity = other.initial_capacity;
+                max_capacity = other.max_capacity;
+                delimiter = other.delimiter;
+                framing = other.framing;
+                fill_short = other.fill_short;
+                other.buffer = nullptr;
+                other.capacity = other.head = other.tail = other.scan = 0;
+        }
+        return *this;
+}
+
+bool recv_buffer::reserve(){
+        if (buffer == nullptr) {
+                buffer = buffer_pool::shared().acquire(initial_capacity, capacity);
+                head = tail = scan = 0;
+                return buffer != nullptr;
+        }
+        if (tail < capacity) {
+                return true;
+        }
+
+        // Everything consumed, just rewind
+        if (head == tail) {
+                head = tail = scan = 0;
+                return true;
+        }
+
+        // Move the partial message back to the front
+        if (head > 0) {
+                size_t pending = tail - head;
+                std::memmove(buffer, buffer + head, pending);
+                scan -= head;
+                tail = pending;
+                head = 0;
+                return true;
+        }
+
+        // A single message fills the whole buffer, grow it
+        if (capacity >= max_capacity) {
+                return false;
+        }
+        size_t new_capacity = capacity * 2;
+        if (new_capacity > max_capacity) {
+                new_capacity = max_capacity;
+        }
+        char* new_buffer = buffer_pool::shared().acquire(new_capacity, new_capacity);
+        if (new_buffer == nullptr) {
+                return false;
+        }
+        std::memcpy(new_buffer, buffer, tail);
+        buffer_pool::shared().release(buffer, capacity);
+        buffer = new_buffer;
+        capacity = new_capacity;
+        return true;
+}
+
+void recv_buffer::release_idle(){
+        if (buffer != nullptr && head == tail && fill_short) {
+                buffer_pool::shared().release(buffer, capacity);
+                buffer = nullptr;
+                capacity = head = tail = scan = 0;
+        }
+}
+
+long recv_buffer::fill(int fd){
+        if ( !reserve() ) {
+                fill_short = false;
+                errno = EMSGSIZE;
+                return -1;
+        }
+        size_t requested = capacity - tail;
+        long num_bytes = (long) read(fd, buffer + tail, requested);
+        fill_short = (num_bytes < (long) requested);
+        if (num_bytes > 0) {
+                tail += (size_t) num_bytes;
+                RSOCKET_COUNT(METRIC_BYTES_IN, num_bytes);
+        } else {
+                int errsv = errno;
+                if (num_bytes < 0 && (errsv == EAGAIN || errsv == EWOULDBLOCK)) {
+                        RSOCKET_COUNT(METRIC_READ_EAGAIN, 1);
+                }
+                release_idle();
+                errno = errsv;
+        }
+        return num_bytes;
+}
+
+bool recv_buffer::append(const char* data, size_t length){
+        if ( size() + length > max_capacity ) {
+                return false;
+        }
+        RSOCKET_COUNT(METRIC_BYTES_IN, length);
+        while (length > 0) {
+                if ( !reserve() ) {
+                        return false;
+                }
+                size_t chunk = std::min(length, capacity - tail);
+                std::memcpy(buffer + tail, data, chunk);
+                tail += chunk;
+                data += chunk;
+                length -= chunk;
+        }
+        // Data handed in is everything that arrived, there is no socket left to drain
+        fill_short = true;
+        return true;
+}
+
+size_t recv_buffer::take(char* destination, size_t max_length){
+        size_t length = std::min(max_length, size());
+        if (length > 0) {
+                std::memcpy(destination, buffer + head, length);
+                head += length;
+                if (scan < head) {
+                        scan = head;
+                }
+        }
+        if (head == tail) {
+                head = tail = scan = 0;
+                release_idle();
+        }
+        return length;
+}
+
+bool recv_buffer::next_frame(frame_view& frame){
+        if (framing == FRAMING_AUTO) {
+                if (head == tail) {
+                        return false;
+                }
+                // Delimited messages never start with NUL, so one byte is enough to rule out the preamble
+                if (buffer[head] != FRAME_PREAMBLE[0]) {
+                        framing = FRAMING_DELIMITED;
+                } else if (tail - head < FRAME_PREAMBLE_SIZE) {
+                        return false;
+                } else if (std::memcmp(buffer + head, FRAME_PREAMBLE, FRAME_PREAMBLE_SIZE) == 0) {
+                        framing = FRAMING_LENGTH_PREFIXED;
+                        head += FRAME_PREAMBLE_SIZE;
+                        scan = head;
+                } else {
+                        framing = FRAMING_DELIMITED;
+                }
+        }
+
+        bool found;
+        if (framing == FRAMING_LENGTH_PREFIXED) {
+                found = next_length_prefixed(frame);
+        } else {
+                found = next_delimited(frame);
+        }
+        if (found) {
+                RSOCKET_COUNT(METRIC_MESSAGES_IN, 1);
+        } else if (head != tail) {
+                RSOCKET_COUNT(METRIC_PARTIAL_READS, 1);
+        }
+
+        // Rewind for free once everything is consumed
+        if (head == tail) {
+                head = tail = scan = 0;
+                // Views handed out earlier die here (documented), not while the caller may still use the last one
+                if (!found) {
+                        release_idle();
+                }
+        }
+        return found;
+}
+
+bool recv_buffer::next_delimited(frame_view& frame){
+        if (scan >= tail) {
+                return false;
+        }
+        const char* found = (const char*) std::memchr(buffer + scan, delimiter, tail - scan);
+        if (found == nullptr) {
+                // Partial message, resume from here after the next fill()
+                scan = tail;
+                return false;
+        }
+
+        size_t end = (size_t) (found - buffer);
+        frame.data = buffer + head;
+        frame.size = end - head;
+        head = scan = end + 1;
+        return true;
+}
+
+// O(1) per message: the header says exactly where the message ends
+bool recv_buffer::next_length_prefixed(frame_view& frame){
+        if (tail - head < FRAME_HEADER_SIZE) {
+                return false;
+        }
+        size_t length = decode_frame_header(buffer + head);
+        if (tail - head - FRAME_HEADER_SIZE < length) {
+                // fill() grows the buffer towards max_capacity until the whole message fits
+                return false;
+        }
+
+        frame.data = buffer + head + FRAME_HEADER_SIZE;
+        frame.size = length;
+        head = scan = head + FRAME_HEADER_SIZE + length;
+        return true;
+}
+
+bool recv_buffer::last_read_short(){
+        return fill_short;
+}
+
+size_t recv_buffer::size(){
+        return tail - head;
+}
+
+size_t recv_buffer::free_space(){
+        return capacity - tail;
+}
+
+size_t recv_buffer::allocated(){
+        return capacity;
+}
+
+void recv_buffer::clear(){
+        buffer_pool::shared().release(buffer, capacity);
+        buffer = nullptr;
+        capacity = head = tail = scan = 0;
+}
@@ -0,0 +1,122 @@
+//--------------------------
+// Receive buffer module header
+//--------------------------
+// Description:
+// Per-connection receive buffer with incremental message framing
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#ifndef _recv_buffer_H_INCLUDED
+#define _recv_buffer_H_INCLUDED
+
+// Default settings
+//-----------------------------
+// Default initial receive buffer size
+#define DEFAULT_RECV_BUFFER_SIZE 4096
+// Default limit the buffer may grow to while waiting for the end of a message
+#define DEFAULT_MAX_RECV_BUFFER_SIZE (1024 * 1024)
+// Default message delimiter
+#define DEFAULT_MESSAGE_DELIMITER '!'
+//-----------------------------
+
+// Includes
+//-----------------------------
+// Standard libraries
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <utility>
+
+#include "buffer_pool.h"
+#include "framing.h"
+#include "metrics.h"
+//-----------------------------
+
+// Bytes are appended at tail by fill() and complete messages are consumed from head by next_frame()
+// Leftover bytes of a partial message stay buffered across reads. Unread bytes are moved back to the
+// front only when the tail runs out of room, so frames are always contiguous and returned without copying
+// Memory is leased from buffer_pool::shared() on the first fill() and handed back once the buffer is
+// empty and the socket drained, so idle connections hold no receive memory
+class recv_buffer
+{
+    private:
+        char* buffer = nullptr;
+        size_t capacity = 0;
+        // Start of unconsumed data
+        size_t head = 0;
+        // End of received data
+        size_t tail = 0;
+        // Position the delimiter search resumes from, bytes before it are known not to be delimiters
+        size_t scan = 0;
+        // Last fill() returned less than the free space offered (socket drained)
+        bool fill_short = false;
+
+        bool next_delimited(frame_view& frame);
+        bool next_length_prefixed(frame_view& frame);
+
+        // Make room for at least one more read, returns false if max_capacity is reached
+        bool reserve();
+        // Hand the memory back if nothing is buffered and the socket was drained
+        void release_idle();
+
+    public:
+        // Initial lease size (rounded up to a buffer_pool size class), nothing is leased until the first fill()
+        size_t initial_capacity;
+        // Largest message (plus unconsumed data) the buffer will hold
+        size_t max_capacity;
+        // Message delimiter (FRAMING_DELIMITED)
+        char delimiter = DEFAULT_MESSAGE_DELIMITER;
+        // How messages are separated, FRAMING_AUTO resolves itself from the first bytes received
+        framing_mode framing = FRAMING_DELIMITED;
+
+        recv_buffer();
+        recv_buffer(size_t i_c, size_t m_c);
+        ~recv_buffer();
+
+        recv_buffer(const recv_buffer&) = delete;
+        recv_buffer& operator=(const recv_buffer&) = delete;
+        recv_buffer(recv_buffer&& other) noexcept;
+        recv_buffer& operator=(recv_buffer&& other) noexcept;
+
+        // Single read() from fd into free space
+        // Returns bytes read, 0 on EOF, -1 on error (EMSGSIZE if a message exceeds max_capacity)
+        long fill(int fd);
+
+        // Copy bytes that were received some other way (e.g., an io_uring provided buffer) into the buffer
+        // Returns false (nothing copied) if they don't fit within max_capacity
+        bool append(const char* data, size_t length);
+
+        // Consume up to max_length raw bytes, ignoring framing, returns bytes copied to destination
+        size_t take(char* destination, size_t max_length);
+
+        // Extract the next complete message (without its delimiter / length header)
+        // Returns false if only a partial message is buffered
+        // The view is valid until the next fill() / append(), or until next_frame() returns false
+        // with nothing left buffered (the memory is handed back to the pool then)
+        bool next_frame(frame_view& frame);
+
+        // True if the last fill() did not fill all free space, i.e. the socket had no more data
+        bool last_read_short();
+
+        // Number of buffered, unconsumed bytes
+        size_t size();
+
+        // Free space left before the buffer has to compact or grow
+        size_t free_space();
+
+        // Memory currently leased (0 while idle)
+        size_t allocated();
+
+        // Drop all buffered data and hand the memory back
+        void clear();
+};
+
+#endif // recv_buffer.h
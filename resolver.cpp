@@ -0,0 +1,181 @@
+//--------------------------
+// Resolver module
+//--------------------------
+// Description:
+// Thread-safe host name resolution (getaddrinfo) with a TTL cache and a pool of lookup threads
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#include "resolver.h"
+
+static std::string cache_key(const std::string& host, uint16_t port, int family, int type){
+        return host + ":" + std::to_string(port) + ":" + std::to_string(family) + ":" + std::to_string(type);
+}
+
+// getaddrinfo() itself is thread-safe, unlike gethostbyname()
+static int query(const char* host, uint16_t port, int family, int type, std::vector<resolved_address>& addresses){
+        struct addrinfo hints;
+        memset(&hints, 0, sizeof(hints));
+        hints.ai_family = family;
+        hints.ai_socktype = type;
+        hints.ai_flags = AI_NUMERICSERV | AI_ADDRCONFIG;
+
+        std::string service = std::to_string(port);
+        struct addrinfo* results = nullptr;
+        int error = getaddrinfo(host, service.c_str(), &hints, &results);
+        if (error != 0) {
+                return error;
+        }
+
+        addresses.clear();
+        for (struct addrinfo* ai = results; ai != nullptr; ai = ai->ai_next) {
+                resolved_address entry;
+                memset(&entry, 0, sizeof(entry));
+                memcpy(&entry.address, ai->ai_addr, ai->ai_addrlen);
+                entry.length = ai->ai_addrlen;
+                entry.family = ai->ai_family;
+                entry.type = ai->ai_socktype;
+                entry.protocol = ai->ai_protocol;
+                addresses.push_back(entry);
+        }
+        freeaddrinfo(results);
+        return addresses.empty() ? EAI_NONAME : 0;
+}
+
+//-----------------------------
+// Class: resolver
+//-----------------------------
+
+resolver::resolver() : resolver(DEFAULT_RESOLVER_THREADS, DEFAULT_RESOLVER_TTL) {
+}
+
+resolver::resolver(unsigned t_c, unsigned t){
+        thread_count = (t_c > 0) ? t_c : 1;
+        ttl = t;
+}
+
+resolver::~resolver(){
+        {
+                std::lock_guard<std::mutex> guard(lock);
+                stopping = true;
+        }
+        jobs_ready.notify_all();
+        for (auto& thread : threads) {
+                thread.join();
+        }
+}
+
+resolver& resolver::shared(){
+        static resolver instance;
+        return instance;
+}
+
+bool resolver::cached(const std::string& key, std::vector<resolved_address>& addresses){
+        auto entry = cache.find(key);
+        if (entry == cache.end()) {
+                return false;
+        }
+        if (entry->second.expires <= std::chrono::steady_clock::now()) {
+                cache.erase(entry);
+                return false;
+        }
+        addresses = entry->second.addresses;
+        return true;
+}
+
+void resolver::store(const std::string& key, const std::vector<resolved_address>& addresses){
+        if (ttl == 0) {
+                return;
+        }
+        cache_entry& entry = cache[key];
+        entry.expires = std::chrono::steady_clock::now() + std::chrono::milliseconds(ttl);
+        entry.addresses = addresses;
+}
+
+int resolver::lookup(const char* host, uint16_t port, int family, int type, std::vector<resolved_address>& addresses){
+        std::string key = cache_key(host, port, family, type);
+        {
+                std::lock_guard<std::mutex> guard(lock);
+                if ( cached(key, addresses) ) {
+                        return 0;
+                }
+        }
+
+        int error = query(host, port, family, type, addresses);
+        if (error != 0) {
+                RSOCKET_LOG_DEBUG("Lookup of %s failed: %s", host, gai_strerror(error));
+                return error;
+        }
+        std::lock_guard<std::mutex> guard(lock);
+        store(key, addresses);
+        return 0;
+}
+
+void resolver::resolve(const std::string& host, uint16_t port, int family, int type, resolve_callback callback){
+        std::string key = cache_key(host, port, family, type);
+        std::vector<resolved_address> addresses;
+        {
+                std::unique_lock<std::mutex> guard(lock);
+                if ( !cached(key, addresses) ) {
+                        std::vector<resolve_callback>& callbacks = waiting[key];
+                        callbacks.push_back(std::move(callback));
+                        if (callbacks.size() > 1) {
+                                // Same name is already being looked up
+                                return;
+                        }
+                        jobs.push_back(lookup_job{key, host, port, family, type});
+                        // Threads are only started once something is resolved asynchronously
+                        if ( threads.size() < thread_count && threads.size() < jobs.size() + 1 ) {
+                                threads.emplace_back(&resolver::worker, this);
+                        }
+                        guard.unlock();
+                        jobs_ready.notify_one();
+                        return;
+                }
+        }
+        callback(0, addresses);
+}
+
+void resolver::worker(){
+        std::unique_lock<std::mutex> guard(lock);
+        while (true) {
+                jobs_ready.wait(guard, [this]() { return stopping || !jobs.empty(); });
+                if (stopping) {
+                        return;
+                }
+                lookup_job job = std::move(jobs.front());
+                jobs.pop_front();
+                guard.unlock();
+
+                std::vector<resolved_address> addresses;
+                int error = query(job.host.c_str(), job.port, job.family, job.type, addresses);
+                if (error != 0) {
+                        RSOCKET_LOG_DEBUG("Lookup of %s failed: %s", job.host.c_str(), gai_strerror(error));
+                }
+
+                guard.lock();
+                if (error == 0) {
+                        store(job.key, addresses);
+                }
+                std::vector<resolve_callback> callbacks;
+                callbacks.swap(waiting[job.key]);
+                waiting.erase(job.key);
+                guard.unlock();
+
+                for (auto& callback : callbacks) {
+                        callback(error, addresses);
+                }
+                guard.lock();
+        }
+}
+
+void resolver::clear_cache(){
+        std::lock_guard<std::mutex> guard(lock);
+        cache.clear();
+}
@@ -0,0 +1,119 @@
+//--------------------------
+// Resolver module header
+//--------------------------
+// Description:
+// Thread-safe host name resolution (getaddrinfo) with a TTL cache and a pool of lookup threads
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#ifndef _resolver_H_INCLUDED
+#define _resolver_H_INCLUDED
+
+// Default settings
+//-----------------------------
+// Lookup threads, started on the first resolve()
+#define DEFAULT_RESOLVER_THREADS 4
+// How long (ms) a successful lookup is reused
+#define DEFAULT_RESOLVER_TTL 30000
+//-----------------------------
+
+// Includes
+//-----------------------------
+// Standard libraries
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+// Inet libraries
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netdb.h>
+
+#include "logger.h"
+//-----------------------------
+
+struct resolved_address
+{
+        struct sockaddr_storage address;
+        socklen_t length;
+        int family;
+        int type;
+        int protocol;
+};
+
+// error is 0 or a getaddrinfo() EAI_* code (see gai_strerror())
+typedef std::function<void(int error, const std::vector<resolved_address>& addresses)> resolve_callback;
+
+class resolver
+{
+    private:
+        struct cache_entry
+        {
+                std::chrono::steady_clock::time_point expires;
+                std::vector<resolved_address> addresses;
+        };
+
+        struct lookup_job
+        {
+                std::string key;
+                std::string host;
+                uint16_t port;
+                int family;
+                int type;
+        };
+
+        std::mutex lock;
+        std::condition_variable jobs_ready;
+        std::deque<lookup_job> jobs;
+        std::vector<std::thread> threads;
+        bool stopping = false;
+
+        std::unordered_map<std::string, cache_entry> cache;
+        // Callbacks waiting on a lookup that is already queued, so a burst of connects to one host is one query
+        std::unordered_map<std::string, std::vector<resolve_callback>> waiting;
+
+        bool cached(const std::string& key, std::vector<resolved_address>& addresses);
+        void store(const std::string& key, const std::vector<resolved_address>& addresses);
+        void worker();
+
+    public:
+        // Lookup threads
+        unsigned thread_count;
+        // Cache lifetime of a successful lookup (ms), 0 disables the cache
+        unsigned ttl;
+
+        resolver();
+        resolver(unsigned t_c, unsigned t);
+        //------thread_count, ttl
+        ~resolver();
+
+        resolver(const resolver&) = delete;
+        resolver& operator=(const resolver&) = delete;
+
+        // Resolve on the calling thread (cache first)
+        // family is AF_INET / AF_INET6 / AF_UNSPEC, type is SOCK_STREAM / SOCK_DGRAM
+        // Returns 0 or an EAI_* code
+        int lookup(const char* host, uint16_t port, int family, int type, std::vector<resolved_address>& addresses);
+
+        // Resolve on the lookup threads, callback runs there (or right here on a cache hit)
+        void resolve(const std::string& host, uint16_t port, int family, int type, resolve_callback callback);
+
+        void clear_cache();
+
+        // Process wide resolver used by client_socket::c_connect() and connector
+        static resolver& shared();
+};
+
+#endif // resolver.h
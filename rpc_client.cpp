@@ -0,0 +1,183 @@
+//--------------------------
+// RPC client module
+//--------------------------
+// Description:
+// Pipelined request / reply on top of a client_socket: many requests in flight,
+// replies matched by correlation id and completed out of order, per-request deadlines
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#include "rpc_client.h"
+
+//-----------------------------
+// Class: rpc_client
+//-----------------------------
+
+rpc_client::rpc_client(client_socket& s) : socket(s) {
+        rx.framing = FRAMING_LENGTH_PREFIXED;
+}
+
+rpc_client::~rpc_client(){
+}
+
+uint64_t rpc_client::call(const char* data, size_t length, int timeout, rpc_callback callback, bool more){
+        if (broken != 0) {
+                errno = broken;
+                return 0;
+        }
+        if (length + RPC_ID_SIZE > UINT32_MAX) {
+                errno = EMSGSIZE;
+                return 0;
+        }
+        if ( socket.c_framing != FRAMING_LENGTH_PREFIXED && socket.c_negotiate_framing() < 0 ) {
+                return 0;
+        }
+
+        uint64_t id = next_id++;
+        char header[FRAME_HEADER_SIZE + RPC_ID_SIZE];
+        encode_frame_header((uint32_t) (length + RPC_ID_SIZE), header);
+        encode_rpc_id(id, header + FRAME_HEADER_SIZE);
+
+        struct iovec iov[2];
+        iov[0].iov_base = header;
+        iov[0].iov_len = sizeof(header);
+        iov[1].iov_base = (void*) data;
+        iov[1].iov_len = length;
+        if ( send_iov_all(socket.c_sockfd, iov, 2, more ? MSG_MORE : 0) < 0 ) {
+                int errsv = errno;
+                RSOCKET_LOG_ERROR("Error sending request (errno %d)", errsv);
+                errno = errsv;
+                return 0;
+        }
+
+        pending_call& pending = calls[id];
+        pending.callback = std::move(callback);
+        pending.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+        deadlines.push(std::make_pair(pending.deadline, id));
+        return id;
+}
+
+std::future<rpc_reply> rpc_client::call(const char* data, size_t length, int timeout){
+        std::shared_ptr<std::promise<rpc_reply>> promise = std::make_shared<std::promise<rpc_reply>>();
+        std::future<rpc_reply> result = promise->get_future();
+        if ( call(data, length, timeout, [promise](int error, const frame_view& reply) {
+                promise->set_value(rpc_reply{error, std::string(reply.data, reply.size)});
+        }) == 0 ) {
+                promise->set_value(rpc_reply{errno, std::string()});
+        }
+        return result;
+}
+
+void rpc_client::cancel(uint64_t id){
+        calls.erase(id);
+}
+
+// Callback runs after the call is gone, so it may send new requests
+void rpc_client::complete(uint64_t id, int error, const frame_view& reply){
+        auto pending = calls.find(id);
+        if (pending == calls.end()) {
+                // Reply to a request that timed out or was cancelled
+                return;
+        }
+        rpc_callback callback = std::move(pending->second.callback);
+        calls.erase(pending);
+        completed++;
+        callback(error, reply);
+}
+
+void rpc_client::fail_all(int error){
+        broken = error;
+        std::vector<uint64_t> ids;
+        ids.reserve(calls.size());
+        for (auto& pending : calls) {
+                ids.push_back(pending.first);
+        }
+        frame_view empty = {nullptr, 0};
+        for (uint64_t id : ids) {
+                complete(id, error, empty);
+        }
+}
+
+void rpc_client::expire(){
+        time_point now = std::chrono::steady_clock::now();
+        frame_view empty = {nullptr, 0};
+        while ( !deadlines.empty() && deadlines.top().first <= now ) {
+                uint64_t id = deadlines.top().second;
+                deadlines.pop();
+                complete(id, ETIMEDOUT, empty);
+        }
+}
+
+int rpc_client::poll(int timeout){
+        completed = 0;
+        if (broken != 0) {
+                errno = broken;
+                return -1;
+        }
+
+        // Completed calls leave their deadline behind, drop those first
+        while ( !deadlines.empty() && calls.count(deadlines.top().second) == 0 ) {
+                deadlines.pop();
+        }
+        if ( !deadlines.empty() ) {
+                auto until = std::chrono::duration_cast<std::chrono::milliseconds>(deadlines.top().first - std::chrono::steady_clock::now()).count() + 1;
+                if (until < 0) {
+                        until = 0;
+                }
+                if (timeout < 0 || until < timeout) {
+                        timeout = (int) until;
+                }
+        }
+
+        struct pollfd pfd;
+        pfd.fd = socket.c_sockfd;
+        pfd.events = POLLIN;
+        // The socket is blocking, so only read while poll() says there is something to read
+        while (true) {
+                pfd.revents = 0;
+                int ready = ::poll(&pfd, 1, timeout);
+                if (ready < 0 && errno != EINTR) {
+                        int errsv = errno;
+                        RSOCKET_LOG_ERROR("poll failed (errno %d)", errsv);
+                        return -1;
+                }
+                if (ready <= 0) {
+                        break;
+                }
+
+                long num_bytes = rx.fill(socket.c_sockfd);
+                if (num_bytes <= 0) {
+                        int error = (num_bytes == 0) ? ECONNRESET : errno;
+                        RSOCKET_LOG_ERROR("RPC connection lost (errno %d)", error);
+                        fail_all(error);
+                        return completed;
+                }
+
+                frame_view frame;
+                while ( rx.next_frame(frame) ) {
+                        uint64_t id;
+                        frame_view body;
+                        if ( split_rpc_frame(frame, id, body) ) {
+                                complete(id, 0, body);
+                        }
+                }
+                if ( rx.last_read_short() ) {
+                        break;
+                }
+                // More may be pending, look again without waiting
+                timeout = 0;
+        }
+
+        expire();
+        return completed;
+}
+
+size_t rpc_client::pending(){
+        return calls.size();
+}
@@ -0,0 +1,116 @@
+//--------------------------
+// RPC client module header
+//--------------------------
+// Description:
+// Pipelined request / reply on top of a client_socket: many requests in flight,
+// replies matched by correlation id and completed out of order, per-request deadlines
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#ifndef _rpc_client_H_INCLUDED
+#define _rpc_client_H_INCLUDED
+
+// Default settings
+//-----------------------------
+// Default time (ms) a request waits for its reply
+#define DEFAULT_RPC_TIMEOUT 5000
+//-----------------------------
+
+// Includes
+//-----------------------------
+// Standard libraries
+#include <cerrno>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <poll.h>
+
+#include "client_socket.h"
+#include "framing.h"
+#include "logger.h"
+#include "recv_buffer.h"
+//-----------------------------
+
+// Wire format: every request and reply is a length-prefixed message (see framing.h) whose payload starts
+// with the RPC_ID_SIZE byte correlation id. Servers answer with server_socket::s_reply()
+
+// error is 0, ETIMEDOUT, or the errno that broke the connection (reply is empty then)
+// reply points into the receive buffer and is only valid during the callback
+typedef std::function<void(int error, const frame_view& reply)> rpc_callback;
+
+struct rpc_reply
+{
+        int error;
+        std::string data;
+};
+
+// Not thread-safe: call() and poll() belong to one thread, callbacks run inside poll()
+class rpc_client
+{
+    private:
+        typedef std::chrono::steady_clock::time_point time_point;
+
+        struct pending_call
+        {
+                rpc_callback callback;
+                time_point deadline;
+        };
+
+        client_socket& socket;
+        recv_buffer rx;
+        uint64_t next_id = 1;
+        // errno of the failure that broke the connection, 0 while it works
+        int broken = 0;
+
+        std::unordered_map<uint64_t, pending_call> calls;
+        // Earliest deadline first, entries of completed calls are skipped
+        std::priority_queue<std::pair<time_point, uint64_t>, std::vector<std::pair<time_point, uint64_t>>,
+                            std::greater<std::pair<time_point, uint64_t>>> deadlines;
+
+        // Requests completed by the current poll()
+        int completed = 0;
+
+        void complete(uint64_t id, int error, const frame_view& reply);
+        void fail_all(int error);
+        void expire();
+
+    public:
+        // Uses (does not own) socket, which must be connected. Switches it to length-prefixed framing
+        // with c_negotiate_framing() before the first request unless it already is
+        explicit rpc_client(client_socket& s);
+        ~rpc_client();
+
+        rpc_client(const rpc_client&) = delete;
+        rpc_client& operator=(const rpc_client&) = delete;
+
+        // Send a request, callback runs from poll() when its reply arrives or after timeout ms
+        // more = true passes MSG_MORE, so a burst of requests can leave in fewer packets (end the burst with false)
+        // Returns the correlation id, or 0 if the request could not be sent (errno set, callback not called)
+        uint64_t call(const char* data, size_t length, int timeout, rpc_callback callback, bool more = false);
+
+        // Same, the future becomes ready from poll()
+        std::future<rpc_reply> call(const char* data, size_t length, int timeout = DEFAULT_RPC_TIMEOUT);
+
+        // Forget a request, its callback is not called and a late reply is dropped
+        void cancel(uint64_t id);
+
+        // Wait up to timeout ms (capped at the earliest deadline) for replies and complete them
+        // Returns the number of requests completed, or -1 once the connection is broken
+        int poll(int timeout);
+
+        // Requests waiting for a reply
+        size_t pending();
+};
+
+#endif // rpc_client.h
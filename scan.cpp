@@ -0,0 +1,121 @@
+//--------------------------
+// Scanning module
+//--------------------------
+// Description:
+// Vectorized delimiter scanning for the comma / '!' message protocol
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#include "scan.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SCAN_X86 1
+#include <immintrin.h>
+#endif
+
+typedef size_t (*scan_kernel)(const char*, size_t, size_t, uint32_t*, size_t);
+
+// Every kernel scans data[base..size) and writes absolute offsets
+static size_t scan_scalar(const char* data, size_t size, size_t base, uint32_t* offsets, size_t max_offsets){
+        size_t found = 0;
+        for (size_t i = base; i < size && found < max_offsets; i++) {
+                char c = data[i];
+                if (c == ',' || c == '!' || c == '\0') {
+                        offsets[found++] = (uint32_t) i;
+                }
+        }
+        return found;
+}
+
+#ifdef SCAN_X86
+
+// Turn one block's match mask into offsets, lowest bit first
+static inline size_t emit_matches(uint32_t mask, size_t base, uint32_t* offsets, size_t found, size_t max_offsets){
+        while (mask != 0 && found < max_offsets) {
+                offsets[found++] = (uint32_t) (base + (size_t) __builtin_ctz(mask));
+                mask &= mask - 1;
+        }
+        return found;
+}
+
+__attribute__((target("sse2")))
+static size_t scan_sse2(const char* data, size_t size, size_t base, uint32_t* offsets, size_t max_offsets){
+        const __m128i comma = _mm_set1_epi8(',');
+        const __m128i bang = _mm_set1_epi8('!');
+        const __m128i zero = _mm_setzero_si128();
+
+        size_t found = 0;
+        size_t i = base;
+        for (; i + 16 <= size && found < max_offsets; i += 16) {
+                __m128i block = _mm_loadu_si128((const __m128i*) (data + i));
+                __m128i hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, comma), _mm_cmpeq_epi8(block, bang)),
+                                            _mm_cmpeq_epi8(block, zero));
+                found = emit_matches((uint32_t) _mm_movemask_epi8(hits), i, offsets, found, max_offsets);
+        }
+        if (found < max_offsets) {
+                found += scan_scalar(data, size, i, offsets + found, max_offsets - found);
+        }
+        return found;
+}
+
+__attribute__((target("avx2")))
+static size_t scan_avx2(const char* data, size_t size, size_t base, uint32_t* offsets, size_t max_offsets){
+        const __m256i comma = _mm256_set1_epi8(',');
+        const __m256i bang = _mm256_set1_epi8('!');
+        const __m256i zero = _mm256_setzero_si256();
+
+        size_t found = 0;
+        size_t i = base;
+        for (; i + 32 <= size && found < max_offsets; i += 32) {
+                __m256i block = _mm256_loadu_si256((const __m256i*) (data + i));
+                __m256i hits = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(block, comma), _mm256_cmpeq_epi8(block, bang)),
+                                               _mm256_cmpeq_epi8(block, zero));
+                found = emit_matches((uint32_t) _mm256_movemask_epi8(hits), i, offsets, found, max_offsets);
+        }
+        // Tail is shorter than one AVX2 block, finish with SSE2 / scalar
+        if (found < max_offsets) {
+                found += scan_sse2(data, size, i, offsets + found, max_offsets - found);
+        }
+        return found;
+}
+
+#endif // SCAN_X86
+
+struct scan_dispatch
+{
+        scan_kernel kernel;
+        const char* name;
+};
+
+// Pick the widest kernel the CPU supports
+static scan_dispatch select_kernel(){
+#ifdef SCAN_X86
+        __builtin_cpu_init();
+        if ( __builtin_cpu_supports("avx2") ) {
+                return scan_dispatch{scan_avx2, "avx2"};
+        }
+        if ( __builtin_cpu_supports("sse2") ) {
+                return scan_dispatch{scan_sse2, "sse2"};
+        }
+#endif
+        return scan_dispatch{scan_scalar, "scalar"};
+}
+
+static const scan_dispatch& dispatch(){
+        static const scan_dispatch selected = select_kernel();
+        return selected;
+}
+
+size_t scan_delimiters(const char* data, size_t size, uint32_t* offsets, size_t max_offsets){
+        return dispatch().kernel(data, size, 0, offsets, max_offsets);
+}
+
+const char* scan_kernel_name(){
+        return dispatch().name;
+}
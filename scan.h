@@ -0,0 +1,33 @@
+//--------------------------
+// Scanning module header
+//--------------------------
+// Description:
+// Vectorized delimiter scanning for the comma / '!' message protocol
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#ifndef _scan_H_INCLUDED
+#define _scan_H_INCLUDED
+
+// Includes
+//-----------------------------
+#include <cstddef>
+#include <cstdint>
+//-----------------------------
+
+// Find the offset of every ',', '!' and '\0' in data[0..size)
+// Offsets are written in ascending order, stops once max_offsets have been found
+// Returns the number of offsets written; if it equals max_offsets, resume after the last one
+// Uses AVX2 or SSE2 when the CPU supports them (checked once at runtime), scalar code otherwise
+size_t scan_delimiters(const char* data, size_t size, uint32_t* offsets, size_t max_offsets);
+
+// Name of the kernel selected at runtime ("avx2", "sse2" or "scalar")
+const char* scan_kernel_name();
+
+#endif // scan.h
@@ -0,0 +1,215 @@
+//--------------------------
+// Send queue module
+//--------------------------
+// Description:
+// Per-connection output buffer for non-blocking sockets, bytes and file ranges (sent with sendfile()) in order
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#include "send_queue.h"
+
+//-----------------------------
+// Class: send_queue
+//-----------------------------
+
+send_queue::~send_queue(){
+        clear();
+}
+
+send_queue::send_queue(send_queue&& other) noexcept {
+        *this = std::move(other);
+}
+
+send_queue& send_queue::operator=(send_queue&& other) noexcept {
+        if (this != &other) {
+                clear();
+                buffer = std::move(other.buffer);
+                head = other.head;
+                base = other.base;
+                files = std::move(other.files);
+                file_bytes = other.file_bytes;
+
+                other.buffer.clear();
+                other.head = 0;
+                other.files.clear();
+                other.file_bytes = 0;
+        }
+        return *this;
+}
+
+size_t send_queue::size(){
+        return buffer.size() - head + file_bytes;
+}
+
+bool send_queue::empty(){
+        return head == buffer.size() && files.empty();
+}
+
+size_t send_queue::bytes_ahead(){
+        if ( files.empty() ) {
+                return buffer.size() - head;
+        }
+        return (size_t) (files.front().position - base) - head;
+}
+
+void send_queue::pop_file(){
+        file_bytes -= files.front().length;
+        close(files.front().fd);
+        files.pop_front();
+        // Buffer fully sent up to here, start over without moving anything
+        if (head == buffer.size()) {
+                base += buffer.size();
+                buffer.clear();
+                head = 0;
+        }
+}
+
+void send_queue::append(const struct iovec* iov, int iovcnt, size_t skip){
+        // Reclaim the sent prefix before growing
+        if (head > 0 && head >= buffer.size() / 2) {
+                buffer.erase(buffer.begin(), buffer.begin() + (long) head);
+                base += head;
+                head = 0;
+        }
+        for (int i = 0; i < iovcnt; i++) {
+                const char* data = (const char*) iov[i].iov_base;
+                size_t length = iov[i].iov_len;
+                if (skip >= length) {
+                        skip -= length;
+                        continue;
+                }
+                buffer.insert(buffer.end(), data + skip, data + length);
+                RSOCKET_COUNT(METRIC_QUEUED_BYTES, length - skip);
+                skip = 0;
+        }
+}
+
+void send_queue::append_file(int file_fd, off_t offset, size_t length){
+        if (length == 0) {
+                close(file_fd);
+                return;
+        }
+        files.push_back(file_range{base + buffer.size(), file_fd, offset, length});
+        file_bytes += length;
+        RSOCKET_COUNT(METRIC_QUEUED_BYTES, length);
+}
+
+size_t send_queue::peek(char* destination, size_t max_length){
+        size_t copied = 0;
+        size_t position = head;
+        auto file = files.begin();
+        while (copied < max_length) {
+                size_t limit = (file == files.end()) ? buffer.size() : (size_t) (file->position - base);
+                size_t length = std::min(limit - position, max_length - copied);
+                if (length > 0) {
+                        std::memcpy(destination + copied, buffer.data() + position, length);
+                        copied += length;
+                        position += length;
+                        continue;
+                }
+                if (file == files.end()) {
+                        break;
+                }
+                long num_bytes = (long) pread(file->fd, destination + copied, std::min(file->length, max_length - copied), file->offset);
+                if (num_bytes <= 0) {
+                        break;
+                }
+                copied += (size_t) num_bytes;
+                if ((size_t) num_bytes < file->length) {
+                        break;
+                }
+                ++file;
+        }
+        return copied;
+}
+
+void send_queue::consume(size_t num_bytes){
+        RSOCKET_COUNT(METRIC_QUEUED_BYTES, -(int64_t) std::min(num_bytes, size()));
+        while (num_bytes > 0 && !empty()) {
+                size_t length = std::min(num_bytes, bytes_ahead());
+                head += length;
+                num_bytes -= length;
+                if (num_bytes == 0 || files.empty()) {
+                        break;
+                }
+                file_range& file = files.front();
+                length = std::min(num_bytes, file.length);
+                file.offset += (off_t) length;
+                file.length -= length;
+                file_bytes -= length;
+                num_bytes -= length;
+                if (file.length == 0) {
+                        pop_file();
+                }
+        }
+        if ( empty() ) {
+                clear();
+        }
+}
+
+long send_queue::flush(int fd){
+        long total = 0;
+        while ( !empty() ) {
+                long num_bytes;
+                size_t ahead = bytes_ahead();
+                if (ahead > 0) {
+                        struct iovec iov;
+                        iov.iov_base = buffer.data() + head;
+                        iov.iov_len = ahead;
+                        // A file follows, let its first pages share a segment with these bytes
+                        num_bytes = send_iov_once(fd, &iov, 1, files.empty() ? 0 : MSG_MORE);
+                        if (num_bytes > 0) {
+                                head += (size_t) num_bytes;
+                        }
+                } else {
+                        file_range& file = files.front();
+                        num_bytes = send_file_once(fd, file.fd, &file.offset, file.length);
+                        if (num_bytes > 0) {
+                                file.length -= (size_t) num_bytes;
+                                file_bytes -= (size_t) num_bytes;
+                                ahead = file.length + (size_t) num_bytes;
+                                if (file.length == 0) {
+                                        pop_file();
+                                }
+                        } else {
+                                ahead = file.length;
+                        }
+                }
+                if (num_bytes < 0) {
+                        // Report the failure now unless something got out, then the next flush will
+                        return total > 0 ? total : -1;
+                }
+                total += num_bytes;
+                RSOCKET_COUNT(METRIC_QUEUED_BYTES, -num_bytes);
+                if ((size_t) num_bytes < ahead) {
+                        // Socket full
+                        break;
+                }
+        }
+        if ( empty() ) {
+                clear();
+        }
+        return total;
+}
+
+void send_queue::clear(){
+        RSOCKET_COUNT(METRIC_QUEUED_BYTES, -(int64_t) size());
+        while ( !files.empty() ) {
+                close(files.front().fd);
+                files.pop_front();
+        }
+        file_bytes = 0;
+        base += buffer.size();
+        buffer.clear();
+        head = 0;
+        // Don't let one burst pin memory for the rest of the connection
+        if (buffer.capacity() > SEND_QUEUE_KEEP_CAPACITY) {
+                std::vector<char>().swap(buffer);
+        }
+}
@@ -0,0 +1,104 @@
+//--------------------------
+// Send queue module header
+//--------------------------
+// Description:
+// Per-connection output buffer for non-blocking sockets, bytes and file ranges (sent with sendfile()) in order
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#ifndef _send_queue_H_INCLUDED
+#define _send_queue_H_INCLUDED
+
+// Default settings
+//-----------------------------
+// Queued bytes at which a connection stops accepting writes
+#define DEFAULT_WRITE_HIGH_WATERMARK (1024 * 1024)
+// Queued bytes a blocked connection has to drain to before it accepts writes again
+#define DEFAULT_WRITE_LOW_WATERMARK (256 * 1024)
+// Queue memory kept around after draining, anything larger is released
+#define SEND_QUEUE_KEEP_CAPACITY (64 * 1024)
+//-----------------------------
+
+// Includes
+//-----------------------------
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <vector>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "socket_io.h"
+//-----------------------------
+
+// Bytes the kernel would not take yet, sent in order once the socket becomes writable again
+class send_queue
+{
+    private:
+        // Part of a file to send once the stream reaches position, the queue owns fd
+        struct file_range
+        {
+                uint64_t position;
+                int fd;
+                off_t offset;
+                size_t length;
+        };
+
+        std::vector<char> buffer;
+        // Start of unsent data
+        size_t head = 0;
+        // Stream position of buffer[0], counts every byte ever queued before it
+        uint64_t base = 0;
+        std::deque<file_range> files;
+        // Unsent bytes in files
+        size_t file_bytes = 0;
+
+        // Buffered bytes before the next file range
+        size_t bytes_ahead();
+        void pop_file();
+
+    public:
+        ~send_queue();
+
+        send_queue() {}
+        send_queue(send_queue&& other) noexcept;
+        send_queue& operator=(send_queue&& other) noexcept;
+        send_queue(const send_queue&) = delete;
+        send_queue& operator=(const send_queue&) = delete;
+
+        // Number of bytes waiting to be sent (including file ranges)
+        size_t size();
+
+        bool empty();
+
+        // Queue everything in iov[0..iovcnt) except the first skip bytes (already sent)
+        void append(const struct iovec* iov, int iovcnt, size_t skip);
+
+        // Queue length bytes of file_fd starting at offset, sent after everything queued so far
+        // Takes ownership of file_fd (closed once sent or cleared), pass a dup() to keep using the file
+        void append_file(int file_fd, off_t offset, size_t length);
+
+        // Copy up to max_length unsent bytes without consuming them, returns bytes copied
+        // File ranges are read with pread(), a short count before the end of the queue means a read failed
+        size_t peek(char* destination, size_t max_length);
+
+        // Drop num_bytes from the front after they were sent some other way (e.g., io_uring)
+        void consume(size_t num_bytes);
+
+        // Send as much as the socket will take without blocking, file ranges go out with sendfile()
+        // Returns bytes sent (0 if the socket is full) or -1
+        long flush(int fd);
+
+        // Drop everything, closing queued files
+        void clear();
+};
+
+#endif // send_queue.h
@@ -0,0 +1,121 @@
+//--------------------------
+// Server group module
+//--------------------------
+// Description:
+// Runs several server_socket reactors on one port, one per worker thread
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#include "server_group.h"
+
+//-----------------------------
+// Class: server_group
+//-----------------------------
+// Default settings can be found in server_socket.h
+//-----------------------------
+
+server_group::server_group() : server_group(0, DEFAULT_PORT) {
+}
+
+server_group::server_group(int w_c, uint16_t s_p)
+        : server_group(w_c, s_p, DEFAULT_ADDRESSING, DEFAULT_CONN_TYPE, DEFAULT_PROTOCOL,
+                       DEFAULT_BIND_ADDRESS, DEFAULT_BACKLOG, DEFAULT_SOCKET_BUFFER_SIZE) {
+}
+
+server_group::server_group(int w_c, uint16_t s_p, sa_family_t s_d, int s_ty, int s_pr, int s_b_a, int bl, int s_b_s)
+        : running(false) {
+        worker_count = w_c;
+        s_port = s_p;
+        s_domain = s_d;
+        s_type = s_ty;
+        s_protocol = s_pr;
+        s_bind_address = s_b_a;
+        backlog = bl;
+        socket_read_buffer_size = s_b_s;
+}
+
+server_group::~server_group(){
+        stop();
+        join();
+}
+
+int server_group::start(std::function<void(server_socket&, int)> worker_main){
+        int n = worker_count;
+        if (n <= 0) {
+                n = (int) std::thread::hardware_concurrency();
+                if (n <= 0) {
+                        n = 1;
+                }
+        }
+
+        int cpus = (int) std::thread::hardware_concurrency();
+
+        // Bring up every listener before starting any thread so a bind failure is reported here
+        workers.clear();
+        for (int i = 0; i < n; i++) {
+                std::unique_ptr<server_socket> server(new server_socket(s_port, s_domain, s_type, s_protocol,
+                                                                        s_bind_address, backlog, socket_read_buffer_size));
+                server->s_reuseport = true;
+                server->s_options = s_options;
+                // s_init() runs on this thread, not the worker's
+                server->s_options.cpu = SOCKET_OPTION_UNSET;
+                if ( pin_workers && cpus > 0 && s_options.incoming_cpu == SOCKET_OPTION_UNSET ) {
+                        server->s_options.incoming_cpu = i % cpus;
+                }
+                int err = server->s_init();
+                if (err != 0) {
+                        RSOCKET_LOG_ERROR("Failed to start worker %d (error %d)", i, err);
+                        workers.clear();
+                        return err;
+                }
+                workers.push_back(std::move(server));
+        }
+
+        running = true;
+        for (int i = 0; i < n; i++) {
+                server_socket* server = workers[i].get();
+                threads.emplace_back([worker_main, server, i]() {
+                        worker_main(*server, i);
+                });
+
+                if (pin_workers && cpus > 0) {
+                        cpu_set_t cpu_set;
+                        CPU_ZERO(&cpu_set);
+                        CPU_SET(i % cpus, &cpu_set);
+                        // Best effort, the worker still runs if pinning is not permitted
+                        pthread_setaffinity_np(threads.back().native_handle(), sizeof(cpu_set), &cpu_set);
+                }
+        }
+        return 0;
+}
+
+void server_group::stop(){
+        running = false;
+}
+
+void server_group::join(){
+        for (auto& t : threads) {
+                if (t.joinable()) {
+                        t.join();
+                }
+        }
+        threads.clear();
+}
+
+bool server_group::is_running(){
+        return running;
+}
+
+int server_group::size(){
+        return (int) workers.size();
+}
+
+server_socket& server_group::worker(int worker_id){
+        return *workers[worker_id];
+}
@@ -0,0 +1,87 @@
+//--------------------------
+// Server group module header
+//--------------------------
+// Description:
+// Runs several server_socket reactors on one port, one per worker thread
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#ifndef _server_group_H_INCLUDED
+#define _server_group_H_INCLUDED
+
+// Includes
+//-----------------------------
+// Standard libraries
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+// Thread affinity
+#include <pthread.h>
+#include <sched.h>
+
+#include "server_socket.h"
+//-----------------------------
+
+// Starts N workers, each with its own SO_REUSEPORT listener, epoll loop, read buffer and clients
+// The kernel spreads incoming connections across the listeners, so workers share no state or locks
+class server_group
+{
+    private:
+        std::vector<std::unique_ptr<server_socket>> workers;
+        std::vector<std::thread> threads;
+        std::atomic<bool> running;
+
+    public:
+        // Number of workers (0 = one per online CPU)
+        int worker_count;
+        // Pin worker i to CPU i (modulo CPU count)
+        bool pin_workers = true;
+
+        // Parameters passed through to every worker's server_socket
+        uint16_t s_port;
+        sa_family_t s_domain;
+        int s_type;
+        int s_protocol;
+        int s_bind_address;
+        int backlog;
+        int socket_read_buffer_size;
+        // Socket tuning for every worker. With pin_workers, a worker whose incoming_cpu is unset gets its
+        // own CPU (SO_INCOMING_CPU), and cpu is ignored (the group pins its threads itself)
+        socket_options s_options;
+
+        server_group();
+        server_group(int w_c, uint16_t s_p);
+        server_group(int w_c, uint16_t s_p, sa_family_t s_d, int s_ty, int s_pr, int s_b_a, int bl, int s_b_s);
+        //-----------worker_count, s_port, s_domain, s_type, s_protocol, s_bind_address, backlog, socket_read_buffer_size
+        ~server_group();
+
+        server_group(const server_group&) = delete;
+        server_group& operator=(const server_group&) = delete;
+
+        // Create and initialize every listener, then run worker_main(server, worker_id) on its own thread
+        // worker_main should loop while is_running()
+        // 0 = success, anything else is the s_init() error of the first failing worker
+        int start(std::function<void(server_socket&, int)> worker_main);
+
+        // Ask workers to exit their loops
+        void stop();
+
+        // Wait for all worker threads to finish
+        void join();
+
+        bool is_running();
+
+        int size();
+
+        server_socket& worker(int worker_id);
+};
+
+#endif // server_group.h
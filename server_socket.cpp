@@ -8,7 +8,7 @@
 // Email: lmbernar@uark.edu
 //
 // Created July 20th, 2018
-// Modified: November 7th, 2018
+// Modified: October 17th, 2026
 // Version 0.5
 //--------------------------
 
@@ -16,6 +16,33 @@
 
 #include "server_socket.h"
 
+// s_fd_readable flags
+#define FD_READABLE 0x1
+#define FD_QUEUED 0x2
+#define FD_HUP 0x4
+
+// Delimiter offsets collected per scan_delimiters() call in splitBuffer()
+#define SPLIT_SCAN_BATCH 64
+
+// io_uring user_data: operation in the top byte, then 24 bits of generation (or send buffer) and the client number
+#define URING_OP_ACCEPT 1ULL
+#define URING_OP_RECV 2ULL
+#define URING_OP_SEND 3ULL
+
+static uint64_t uring_data(uint64_t op, uint32_t tag, uint32_t index){
+        return (op << 56) | ((uint64_t) (tag & 0xFFFFFF) << 32) | index;
+}
+
+// Timer wheel cookies use the same layout: timer kind, client generation, client number
+#define TIMER_IDLE 1ULL
+#define TIMER_READ 2ULL
+#define TIMER_WRITE 3ULL
+#define TIMER_HEARTBEAT 4ULL
+
+static uint64_t timer_cookie(uint64_t kind, uint32_t generation, uint32_t index){
+        return uring_data(kind, generation, index);
+}
+
 //-----------------------------
 // Class: server_socket
 //-----------------------------
@@ -39,14 +66,9 @@ server_socket::server_socket(){
         // How many clients can be waiting for a connection before new clients get rejected
         backlog = DEFAULT_BACKLOG;
 
-        // "Read" buffer
-        socket_read_buffer = new char[DEFAULT_SOCKET_BUFFER_SIZE];
+        // "Read" buffer, leased from the buffer pool on the first s_read()
+        socket_read_buffer = nullptr;
         socket_read_buffer_size = DEFAULT_SOCKET_BUFFER_SIZE;
-
-        // Initialize read buffer
-        for (int i = 0; i < socket_read_buffer_size; i++) {
-                socket_read_buffer[i] = 0;
-        }
 }
 
 server_socket::server_socket(uint16_t s_p, sa_family_t s_d, int s_ty, int s_pr, int s_b_a, int bl, int s_b_s){
@@ -56,64 +78,221 @@ server_socket::server_socket(uint16_t s_p, sa_family_t s_d, int s_ty, int s_pr,
         s_protocol = s_pr;
         s_bind_address = s_b_a;
         backlog = bl;
-        socket_read_buffer = new char[s_b_s];
+        socket_read_buffer = nullptr;
         socket_read_buffer_size = s_b_s;
+}
+
+server_socket::~server_socket(){
+        s_release();
+}
 
-        // Initialize read buffer
-        for (int i = 0; i < socket_read_buffer_size; i++) {
-                socket_read_buffer[i] = 0;
+server_socket::server_socket(server_socket&& other) noexcept {
+        *this = std::move(other);
+}
+
+server_socket& server_socket::operator=(server_socket&& other) noexcept {
+        if (this != &other) {
+                s_release();
+                s_sockfd = other.s_sockfd;
+                s_epollfd = other.s_epollfd;
+                s_events = std::move(other.s_events);
+                s_accept_ready = other.s_accept_ready;
+                s_poll_returned = other.s_poll_returned;
+                s_last_event = other.s_last_event;
+                s_fd_readable = std::move(other.s_fd_readable);
+                s_fd_client = std::move(other.s_fd_client);
+                s_readable_fds = std::move(other.s_readable_fds);
+                connections = std::move(other.connections);
+                s_uring = std::move(other.s_uring);
+                s_completions = std::move(other.s_completions);
+                s_accepted = std::move(other.s_accepted);
+                s_send_owner = std::move(other.s_send_owner);
+                s_send_waiting = std::move(other.s_send_waiting);
+                s_datagrams = std::move(other.s_datagrams);
+                s_port = other.s_port;
+                s_domain = other.s_domain;
+                s_type = other.s_type;
+                s_protocol = other.s_protocol;
+                s_bind_address = other.s_bind_address;
+                backlog = other.backlog;
+                s_accept_limit = other.s_accept_limit;
+                s_nodelay = other.s_nodelay;
+                s_options = other.s_options;
+                s_framing = other.s_framing;
+                s_write_high_watermark = other.s_write_high_watermark;
+                s_write_low_watermark = other.s_write_low_watermark;
+                s_engine = other.s_engine;
+                s_reuseport = other.s_reuseport;
+                s_path = std::move(other.s_path);
+                s_bound_path = std::move(other.s_bound_path);
+                s_wait = other.s_wait;
+                s_poll_timeout = other.s_poll_timeout;
+                s_spin_usecs = other.s_spin_usecs;
+                s_busy_poll_usecs = other.s_busy_poll_usecs;
+                s_timers = std::move(other.s_timers);
+                s_expired = std::move(other.s_expired);
+                s_now = other.s_now;
+                s_idle_timeout = other.s_idle_timeout;
+                s_read_deadline = other.s_read_deadline;
+                s_write_deadline = other.s_write_deadline;
+                s_heartbeat_interval = other.s_heartbeat_interval;
+                s_heartbeat_message = std::move(other.s_heartbeat_message);
+                socket_read_buffer = other.socket_read_buffer;
+                socket_read_buffer_size = other.socket_read_buffer_size;
+                s_read_capacity = other.s_read_capacity;
+                s_address = other.s_address;
+                s_address_len = other.s_address_len;
+
+                other.s_sockfd = -1;
+                other.s_epollfd = -1;
+                other.socket_read_buffer = nullptr;
+                other.s_read_capacity = 0;
+                other.s_bound_path.clear();
         }
+        return *this;
 }
 
-server_socket::~server_socket(){
-        // Clean up read buffer
-        delete[] socket_read_buffer;
-        // Close socket (destructor, can't output to console)
-        close(s_sockfd);
+// Close epoll instance and socket, return the read buffer (destructor, can't output to console)
+void server_socket::s_release(){
+        buffer_pool::shared().release(socket_read_buffer, s_read_capacity);
+        socket_read_buffer = nullptr;
+        s_read_capacity = 0;
+        s_uring.reset();
+        if (s_epollfd >= 0) {
+                close(s_epollfd);
+                s_epollfd = -1;
+        }
+        if (s_sockfd >= 0) {
+                close(s_sockfd);
+                s_sockfd = -1;
+        }
+        if ( !s_bound_path.empty() ) {
+                unlink(s_bound_path.c_str());
+                s_bound_path.clear();
+        }
+}
+
+// One byte more than socket_read_buffer_size so reads can be NUL terminated for splitBuffer()
+char* server_socket::s_read_scratch(){
+        if (socket_read_buffer == nullptr) {
+                socket_read_buffer = buffer_pool::shared().acquire((size_t) socket_read_buffer_size + 1, s_read_capacity);
+        }
+        return socket_read_buffer;
 }
 
 int server_socket::client_count(){
-        return (int) client_list.size();
+        return connections.size();
+}
+
+int server_socket::client_at(int position){
+        return connections.index_at(position);
+}
+
+int server_socket::client_fd(int client_number){
+        return connections[client_number].fd;
+}
+
+int server_socket::fd_client(int fd){
+        if ( fd < 0 || fd >= (int) s_fd_client.size() ) {
+                return -1;
+        }
+        return s_fd_client[fd];
+}
+
+client_handle server_socket::get_client_handle(int client_number){
+        return connections.handle(client_number);
+}
+
+bool server_socket::client_valid(client_handle handle){
+        return connections.valid(handle);
 }
 
 // Initialize socket and listen
 // 0 = success, -1 = invalid port, anything else is an errno
 int server_socket::s_init(){
+        s_now = timer_now_ms();
+        s_timers = timer_wheel(s_now);
+
+        // Best effort, the server works unpinned
+        if (s_options.cpu >= 0) {
+                pin_thread(s_options.cpu);
+        }
 
         // Check port range
-        if ( (s_port < 0) || (s_port > 65534) ) {
-                std::cout << "\nPort out of range! (0 to 65534)\n\n";
+        if ( s_domain != AF_UNIX && ((s_port < 0) || (s_port > 65534)) ) {
+                RSOCKET_LOG_ERROR("Port out of range! (0 to 65534)");
                 return -1;
         }
 
         // Create and configure socket
         if ( s_create() < 0 ) {
                 int errsv = errno;
-                std::cout << "Failed to create socket!" << std::endl;
+                RSOCKET_LOG_ERROR("Failed to create socket! (errno %d)", errsv);
                 return errsv;
         }
 
         // Bind socket to port (or something)
         if ( s_bind() < 0 ) {
                 int errsv = errno;
-                std::cout << "Failed to bind socket on port " << s_port << std::endl;
+                RSOCKET_LOG_ERROR("Failed to bind socket on port %u (errno %d)", s_port, errsv);
+                return errsv;
+        }
+
+        // Listen for client connections (datagram sockets are read directly)
+        if ( !s_is_datagram() && s_listen() < 0 ) {
+                int errsv = errno;
+                RSOCKET_LOG_ERROR("Failed to listen on port %u, sockfd %d (errno %d)", s_port, s_sockfd, errsv);
                 return errsv;
         }
 
-        // Listen for client connections
-        if ( s_listen() < 0 ) {
+        // Register listener with the event loop, io_uring if requested and available
+        if ( s_engine != ENGINE_EPOLL ) {
+                if ( s_is_datagram() ) {
+                        RSOCKET_LOG_WARN("io_uring engine only serves stream sockets, using epoll");
+                } else if ( uring_engine::supported() && s_uring_init() == 0 ) {
+                        RSOCKET_LOG_INFO("Socket configured. Listening on port %u (io_uring)", s_port);
+                        return 0;
+                } else {
+                        RSOCKET_LOG_WARN("io_uring unavailable (errno %d), falling back to epoll", errno);
+                }
+        }
+        if ( s_epoll_init() < 0 ) {
                 int errsv = errno;
-                std::cout << "Failed to listen on port " << s_port << ", sockfd " << s_sockfd << std::endl;
+                RSOCKET_LOG_ERROR("Failed to create event loop for sockfd %d (errno %d)", s_sockfd, errsv);
                 return errsv;
         }
 
-        std::cout << "Socket configured. Listening on port " << s_port << std::endl;
+        RSOCKET_LOG_INFO("Socket configured. Listening on port %u", s_port);
         return 0;
 }
 
 // Returns file descriptor or -1
 int server_socket::s_create(){
         s_sockfd = socket(s_domain, s_type, s_protocol);
+        if (s_sockfd < 0) {
+                return s_sockfd;
+        }
+
+        // Buffers and busy polling carry over to accepted sockets. Failures are only logged, defaults work too
+        apply_listen_options(s_sockfd, s_options, s_domain != AF_UNIX && !s_is_datagram());
+
+        // Sockets accepted from the listener inherit it. Only an optimization, the loop spins regardless
+        if ( s_wait == WAIT_BUSY_POLL && s_busy_poll_usecs > 0 && s_options.busy_poll_usecs == SOCKET_OPTION_UNSET
+             && setsockopt(s_sockfd, SOL_SOCKET, SO_BUSY_POLL, &s_busy_poll_usecs, sizeof(s_busy_poll_usecs)) < 0 ) {
+                RSOCKET_LOG_WARN("SO_BUSY_POLL %d failed (errno %d), busy polling in user space only", s_busy_poll_usecs, errno);
+        }
+        if (!s_reuseport) {
+                return s_sockfd;
+        }
+
+        // Must be set before bind() on every socket sharing the port
+        int on = 1;
+        if ( setsockopt(s_sockfd, SOL_SOCKET, SO_REUSEPORT, (char *)&on, sizeof(on)) < 0 ) {
+                int errsv = errno;
+                close(s_sockfd);
+                s_sockfd = -1;
+                errno = errsv;
+        }
         return s_sockfd;
 }
 
@@ -127,7 +306,7 @@ int server_socket::s_set_nonblocking(){
         int err = setsockopt(s_sockfd, SOL_SOCKET, SO_REUSEADDR, (char *)&on, sizeof(on));
         if (err < 0) {
                 err = errno;
-                std::cout << "setsockopt() failed" << std::endl;
+                RSOCKET_LOG_ERROR("setsockopt() failed (errno %d)", err);
                 return err;
         }
         // Set socket to be non-blocking. Affects all client sockets as well
@@ -135,7 +314,7 @@ int server_socket::s_set_nonblocking(){
         if (err < 0)
         {
                 err = errno;
-                std::cout << "setsockopt() failed" << std::endl;
+                RSOCKET_LOG_ERROR("setsockopt() failed (errno %d)", err);
                 return err;
         }
         return 0;
@@ -143,6 +322,9 @@ int server_socket::s_set_nonblocking(){
 
 // Returns 0 or -1
 int server_socket::s_bind(){
+        if (s_domain == AF_UNIX) {
+                return s_bind_unix();
+        }
         // IPV4
         s_address.sin_family = s_domain;
         // Bind to localhost
@@ -152,179 +334,1186 @@ int server_socket::s_bind(){
         return bind(s_sockfd, (struct sockaddr *) &s_address, s_address_len);
 }
 
+int server_socket::s_bind_unix(){
+        struct sockaddr_un address;
+        socklen_t length;
+        if ( unix_address(s_path.c_str(), address, length) < 0 ) {
+                return -1;
+        }
+        bool abstract = (s_path[0] == '@');
+
+        // A socket file outlives the server that bound it, only ever remove sockets (not a file that happens to be there)
+        struct stat info;
+        if ( !abstract && lstat(s_path.c_str(), &info) == 0 && S_ISSOCK(info.st_mode) ) {
+                unlink(s_path.c_str());
+        }
+        if ( bind(s_sockfd, (struct sockaddr*) &address, length) < 0 ) {
+                return -1;
+        }
+        if (!abstract) {
+                s_bound_path = s_path;
+        }
+        return 0;
+}
+
 // Listen on port
 int server_socket::s_listen(){
-        return listen(s_sockfd, backlog);
+        int limit = s_max_backlog();
+        int queue = backlog;
+        if (queue > limit) {
+                // The kernel would cap it silently
+                RSOCKET_LOG_WARN("Backlog %d capped to net.core.somaxconn (%d)", queue, limit);
+        }
+        if (queue < 0 || queue > limit) {
+                queue = limit;
+        }
+        return listen(s_sockfd, queue);
+}
+
+int server_socket::s_max_backlog(){
+        int limit = 0;
+        FILE* file = fopen("/proc/sys/net/core/somaxconn", "r");
+        if (file != nullptr) {
+                if (fscanf(file, "%d", &limit) != 1) {
+                        limit = 0;
+                }
+                fclose(file);
+        }
+        return limit > 0 ? limit : SOMAXCONN;
+}
+
+// Create epoll instance and register the listening socket
+// Returns 0 or -1
+int server_socket::s_epoll_init(){
+        s_epollfd = epoll_create1(EPOLL_CLOEXEC);
+        if (s_epollfd < 0) {
+                return -1;
+        }
+        s_events.resize(DEFAULT_MAX_EVENTS);
+
+        // Edge-triggered listener has to be drained until EAGAIN, so accept() must not block
+        int flags = fcntl(s_sockfd, F_GETFL, 0);
+        if ( flags < 0 || fcntl(s_sockfd, F_SETFL, flags | O_NONBLOCK) < 0 ) {
+                return -1;
+        }
+        return s_register(s_sockfd, EPOLLIN | EPOLLET);
+}
+
+io_engine server_socket::s_active_engine(){
+        return s_uring ? ENGINE_URING : ENGINE_EPOLL;
+}
+
+// Add fd to the epoll set and grow the per-fd tables to cover it
+int server_socket::s_register(int fd, uint32_t events){
+        struct epoll_event ev = {0};
+        ev.events = events;
+        ev.data.fd = fd;
+        if ( epoll_ctl(s_epollfd, EPOLL_CTL_ADD, fd, &ev) < 0 ) {
+                return -1;
+        }
+        s_track(fd);
+        return 0;
+}
+
+void server_socket::s_track(int fd){
+        if ( (int) s_fd_readable.size() <= fd ) {
+                s_fd_readable.resize((size_t) fd + 1, 0);
+                s_fd_client.resize((size_t) fd + 1, -1);
+        }
+}
+
+void server_socket::s_set_hangup(int fd){
+        s_set_readable(fd, true);
+        s_fd_readable[fd] |= FD_HUP;
+}
+
+void server_socket::s_set_readable(int fd, bool readable){
+        if ( fd < 0 || fd >= (int) s_fd_readable.size() ) {
+                return;
+        }
+        if (readable) {
+                // Only queue once, the entry stays in s_readable_fds until compacted
+                if ( !(s_fd_readable[fd] & FD_QUEUED) ) {
+                        s_readable_fds.push_back(fd);
+                }
+#if RSOCKET_METRICS
+                int client_number = s_fd_client[fd];
+                if ( client_number >= 0 && connections[client_number].ready_at == 0 ) {
+                        connections[client_number].ready_at = metrics_now_us();
+                }
+#endif
+                s_fd_readable[fd] = FD_READABLE | FD_QUEUED;
+        } else if ( !(s_fd_readable[fd] & FD_HUP) ) {
+                // Peer hung up, stay readable so the caller gets to see EOF
+                s_fd_readable[fd] &= ~FD_READABLE;
+        }
+}
+
+// Wait for accept / read readiness on all registered fds
+// Readiness is latched (edge-triggered), it is only cleared once the fd has been drained
+int server_socket::s_poll(int timeout){
+#if RSOCKET_METRICS
+        // Whatever the caller did since the last s_poll() returned
+        uint64_t now = metrics_now_us();
+        if (s_poll_returned != 0) {
+                RSOCKET_OBSERVE(METRIC_LOOP_ITERATION_US, now - s_poll_returned);
+        }
+        RSOCKET_COUNT(METRIC_LOOP_ITERATIONS, 1);
+#endif
+        // Wake up in time for the next timer
+        long next_timer = s_timers.next_expiry();
+        if ( next_timer >= 0 && (timeout < 0 || next_timer < timeout) ) {
+                timeout = (int) next_timer;
+        }
+        int n = s_wait_events(timeout);
+        int errsv = errno;
+
+        s_now = timer_now_ms();
+        s_timers.advance(s_now, s_expired);
+        for (uint64_t cookie : s_expired) {
+                s_timer_expired(cookie);
+        }
+        s_expired.clear();
+#if RSOCKET_METRICS
+        s_poll_returned = metrics_now_us();
+#endif
+        errno = errsv;
+        return n;
+}
+
+// Spinning is a loop of non-blocking polls, so an event is picked up as soon as it lands
+int server_socket::s_wait_events(int timeout){
+        if (s_wait == WAIT_TIMED || s_wait == WAIT_BLOCKING || timeout == 0) {
+                return s_poll_events(timeout);
+        }
+
+        uint64_t start = metrics_now_us();
+        uint64_t now = start;
+        // Adaptive only spins while the last event is recent, an idle loop goes straight to sleep
+        bool spinning = (s_wait == WAIT_BUSY_POLL) || (now - s_last_event < (uint64_t) s_spin_usecs);
+        while (spinning) {
+                int n = s_poll_events(0);
+                if (n != 0) {
+                        s_last_event = metrics_now_us();
+                        return n;
+                }
+                now = metrics_now_us();
+                if ( timeout > 0 && now - start >= (uint64_t) timeout * 1000 ) {
+                        return 0;
+                }
+                spinning = (s_wait == WAIT_BUSY_POLL) || (now - s_last_event < (uint64_t) s_spin_usecs);
+        }
+
+        // Sleep for whatever is left of the timeout
+        int remaining = timeout;
+        if (timeout > 0) {
+                remaining = timeout - (int) ((now - start) / 1000);
+                if (remaining < 1) {
+                        remaining = 1;
+                }
+        }
+        int n = s_poll_events(remaining);
+        if (n > 0) {
+                s_last_event = metrics_now_us();
+        }
+        return n;
+}
+
+int server_socket::s_idle_wait(){
+        return (s_wait == WAIT_BLOCKING) ? -1 : s_poll_timeout;
+}
+
+int server_socket::s_poll_events(int timeout){
+        if (s_uring) {
+                return s_uring_poll(timeout);
+        }
+        int n = epoll_wait(s_epollfd, s_events.data(), (int) s_events.size(), timeout);
+        if (n < 0) {
+                return (errno == EINTR) ? 0 : -1;
+        }
+        for (int i = 0; i < n; i++) {
+                int fd = s_events[i].data.fd;
+                if (fd == s_sockfd) {
+                        s_accept_ready = true;
+                } else if ( s_events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR) ) {
+                        // Hangups / errors are reported as readable so the caller sees the 0 / -1 from read()
+                        s_set_readable(fd, true);
+                        if ( s_events[i].events & (EPOLLRDHUP | EPOLLHUP | EPOLLERR) ) {
+                                s_fd_readable[fd] |= FD_HUP;
+                        }
+                }
+                if ( (s_events[i].events & EPOLLOUT) && fd != s_sockfd && s_fd_client[fd] >= 0 ) {
+                        // Socket drained some of its send buffer, push out queued replies
+                        s_flush(s_fd_client[fd]);
+                }
+        }
+        return n;
 }
 
 int server_socket::s_accept(){
-        // Open a socket for the client
-        int new_client = accept(s_sockfd, (struct sockaddr*) &s_address, &s_address_len);
+        if (s_uring) {
+                // Already accepted by the multishot accept, just start receiving
+                if ( s_accepted.empty() ) {
+                        s_accept_ready = false;
+                        errno = EAGAIN;
+                        return -1;
+                }
+                int new_client = s_accepted.front();
+                s_accepted.pop_front();
+                s_accept_ready = !s_accepted.empty();
+
+                s_track(new_client);
+                s_client_options(new_client);
+                int client_number = connections.insert(new_client);
+                s_fd_client[new_client] = client_number;
+                connection& conn = connections[client_number];
+                conn.rx.initial_capacity = (size_t) socket_read_buffer_size;
+                conn.rx.framing = s_framing;
+                s_start_timers(client_number);
+                s_uring->arm_recv(new_client, uring_data(URING_OP_RECV, connections.handle(client_number).generation, (uint32_t) client_number));
+                RSOCKET_LOG_DEBUG("New client: %d", new_client);
+                RSOCKET_COUNT(METRIC_ACCEPTS, 1);
+                return new_client;
+        }
+
+        if ( s_is_datagram() ) {
+                errno = EOPNOTSUPP;
+                return -1;
+        }
+
+        // Open a socket for the client, reads are drained until EAGAIN so it must not block
+        int new_client = accept4(s_sockfd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
         if ( new_client  < 0) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                        // Listener drained, wait for the next edge
+                        s_accept_ready = false;
+                } else {
+                        RSOCKET_COUNT(METRIC_ACCEPT_ERRORS, 1);
+                }
                 return -1;
+        }
+
+        if ( s_register(new_client, EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET) < 0 ) {
+                int errsv = errno;
+                close(new_client);
+                RSOCKET_COUNT(METRIC_ACCEPT_ERRORS, 1);
+                errno = errsv;
+                return -1;
+        }
+
+        s_client_options(new_client);
+        RSOCKET_LOG_DEBUG("New client: %d", new_client);
+        // new_client is a file descriptor for the new socket
+        int client_number = connections.insert(new_client);
+        s_fd_client[new_client] = client_number;
+        connection& conn = connections[client_number];
+        conn.rx.initial_capacity = (size_t) socket_read_buffer_size;
+        conn.rx.framing = s_framing;
+        s_start_timers(client_number);
+        RSOCKET_COUNT(METRIC_ACCEPTS, 1);
+        return new_client;
+}
+
+int server_socket::s_accept_all(){
+        if ( s_is_datagram() ) {
+                return 0;
+        }
+        int accepted = 0;
+        for (int attempt = 0; attempt < s_accept_limit && s_accept_ready; attempt++) {
+                if ( s_accept() >= 0 ) {
+                        accepted++;
+                        continue;
+                }
+                int errsv = errno;
+                if (errsv == EAGAIN || errsv == EWOULDBLOCK) {
+                        break;
+                }
+                RSOCKET_LOG_ERROR("Failed to accept client connection (errno %d)", errsv);
+                // The client gave up while queued, the next one may be fine. Anything else (e.g., out of fds)
+                // won't get better by retrying right away
+                if (errsv != ECONNABORTED && errsv != EPROTO) {
+                        break;
+                }
+        }
+        return accepted;
+}
+
+// At most TCP_NODELAY and TCP_QUICKACK, everything else is inherited from the listener
+void server_socket::s_client_options(int fd){
+        if ( s_domain == AF_UNIX || s_is_datagram() ) {
+                return;
+        }
+        if (s_nodelay && s_options.nodelay != 1) {
+                socket_options options = s_options;
+                options.nodelay = 1;
+                apply_accept_options(fd, options, true);
         } else {
-                std::cout << "New client: " << new_client << std::endl;
-                // new_client is a file descriptor for the new socket
-                client_list.push_back(new_client);
-                return new_client;
+                apply_accept_options(fd, s_options, true);
         }
 }
 
 int server_socket::remove_client(int client_num){
-        client_list.erase(client_list.begin()+client_num);
-        return 0;
-}
+        if ( !connections.contains(client_num) ) {
+                return -1;
+        }
+        int fd = connections[client_num].fd;
+        if (s_uring) {
+                // Requests hold their own reference to the socket, cancel them so it really closes
+                s_uring->cancel(uring_data(URING_OP_RECV, connections.handle(client_num).generation, (uint32_t) client_num));
+                if (connections[client_num].tx_buffer >= 0) {
+                        s_uring->cancel(uring_data(URING_OP_SEND, (uint32_t) connections[client_num].tx_buffer, (uint32_t) client_num));
+                }
+        } else {
+                // Fails harmlessly if the caller already closed the fd
+                epoll_ctl(s_epollfd, EPOLL_CTL_DEL, fd, nullptr);
+        }
+        s_fd_readable[fd] &= ~(FD_READABLE | FD_HUP);
+        s_fd_client[fd] = -1;
 
-// Get value of largest client fd for select()
-int server_socket::max_client_fd(){
-        return *( std::max_element(client_list.begin(), client_list.end()) );
+        s_stop_timers(connections[client_num]);
+        connections.erase(client_num);
+        RSOCKET_COUNT(METRIC_CLOSES, 1);
+        return 0;
 }
 
 // Read from the socket buffer of the specified client
 long server_socket::s_read(int s_client){
-        return (long) read(client_list[s_client], socket_read_buffer, (size_t) socket_read_buffer_size);
+        int fd = connections[s_client].fd;
+        s_picked_up(connections[s_client]);
+        if (s_uring) {
+                // Data already arrived through io_uring, hand it out raw
+                connection& conn = connections[s_client];
+                if (s_read_scratch() == nullptr) {
+                        errno = ENOMEM;
+                        return -1;
+                }
+                size_t taken = conn.rx.take(socket_read_buffer, (size_t) socket_read_buffer_size);
+                socket_read_buffer[taken] = '\0';
+                conn.rx_new -= std::min(taken, conn.rx_new);
+                if (taken > 0) {
+                        conn.last_read = s_now;
+                        if ( conn.rx.size() == 0 ) {
+                                s_set_readable(fd, false);
+                        }
+                        return (long) taken;
+                }
+                s_set_readable(fd, false);
+                if (conn.rx_error != 0) {
+                        errno = conn.rx_error;
+                        return -1;
+                }
+                if (conn.rx_eof) {
+                        return 0;
+                }
+                errno = EAGAIN;
+                return -1;
+        }
+        if (connections[s_client].rx_error != 0) {
+                // Timed out, the socket itself may still be fine
+                errno = connections[s_client].rx_error;
+                return -1;
+        }
+        if (s_read_scratch() == nullptr) {
+                errno = ENOMEM;
+                return -1;
+        }
+        long num_bytes = (long) read(fd, socket_read_buffer, (size_t) socket_read_buffer_size);
+        if (num_bytes > 0) {
+                RSOCKET_COUNT(METRIC_BYTES_IN, num_bytes);
+                connections[s_client].stats.bytes_in += (uint64_t) num_bytes;
+                connections[s_client].last_read = s_now;
+        } else if (num_bytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                RSOCKET_COUNT(METRIC_READ_EAGAIN, 1);
+        }
+        // Anything after the data is not part of this read
+        socket_read_buffer[num_bytes > 0 ? num_bytes : 0] = '\0';
+        // A short read (or EOF / EAGAIN / error) means the socket is drained,
+        // the next edge will mark it readable again
+        if ( num_bytes < (long) socket_read_buffer_size ) {
+                int errsv = errno;
+                s_set_readable(fd, false);
+                errno = errsv;
+        }
+        return num_bytes;
 }
 
 int server_socket::s_write(char* data){
-        std::cout << data << std::endl;
-        return -1;
+        return s_broadcast(data, strlen(data));
+}
+
+int server_socket::s_write(int client_number, const char* data, size_t length){
+        if ( s_queue_message(client_number, data, length) < 0 ) {
+                int errsv = errno;
+                if (errsv != ENOBUFS) {
+                        RSOCKET_LOG_ERROR("Error writing to client %d (errno %d)", client_number, errsv);
+                }
+                errno = errsv;
+                return -1;
+        }
+        return 0;
+}
+
+// The header (or delimiter) and the file range are queued back to back, the loop sends both
+int server_socket::s_send_file(int client_number, int file_fd, off_t offset, size_t length){
+        connection& conn = connections[client_number];
+        if (conn.tx_blocked) {
+                errno = ENOBUFS;
+                return -1;
+        }
+        if (conn.rx_eof || conn.rx_error != 0) {
+                errno = EPIPE;
+                return -1;
+        }
+        bool length_prefixed = (conn.rx.framing == FRAMING_LENGTH_PREFIXED);
+        if (length_prefixed && length > UINT32_MAX) {
+                errno = EMSGSIZE;
+                return -1;
+        }
+        int fd = fcntl(file_fd, F_DUPFD_CLOEXEC, 0);
+        if (fd < 0) {
+                int errsv = errno;
+                RSOCKET_LOG_ERROR("Error queueing file for client %d (errno %d)", client_number, errsv);
+                errno = errsv;
+                return -1;
+        }
+
+        static const char delim = '!';
+        char header[FRAME_HEADER_SIZE];
+        struct iovec iov;
+        bool was_empty = conn.tx.empty();
+        conn.stats.messages_out++;
+        RSOCKET_COUNT(METRIC_MESSAGES_OUT, 1);
+        if (length_prefixed) {
+                encode_frame_header((uint32_t) length, header);
+                iov.iov_base = header;
+                iov.iov_len = FRAME_HEADER_SIZE;
+                conn.tx.append(&iov, 1, 0);
+        }
+        conn.tx.append_file(fd, offset, length);
+        if (!length_prefixed) {
+                iov.iov_base = (void*) &delim;
+                iov.iov_len = 1;
+                conn.tx.append(&iov, 1, 0);
+        }
+
+        conn.last_write = s_now;
+        if (was_empty) {
+                conn.last_progress = s_now;
+        }
+
+        if (s_uring) {
+                s_uring_send(client_number);
+        } else if ( was_empty && s_flush(client_number) < 0 ) {
+                int errsv = errno;
+                RSOCKET_LOG_ERROR("Error sending file to client %d (errno %d)", client_number, errsv);
+                errno = errsv;
+                return -1;
+        }
+        if ( conn.tx.size() >= s_write_high_watermark ) {
+                conn.tx_blocked = true;
+        }
+        if ( s_write_deadline > 0 && !conn.tx.empty() ) {
+                s_arm(client_number, TIMER_WRITE, conn.write_timer, (uint64_t) s_write_deadline);
+        }
+        return 0;
+}
+
+int server_socket::s_accept_shm(int client_number, shm_channel& channel, int timeout){
+        if ( !connections.contains(client_number) ) {
+                errno = EINVAL;
+                return -1;
+        }
+        if (s_uring || s_domain != AF_UNIX) {
+                errno = EOPNOTSUPP;
+                return -1;
+        }
+        if ( channel.accept(connections[client_number].fd, timeout) < 0 ) {
+                int errsv = errno;
+                RSOCKET_LOG_ERROR("Client %d: no shared memory channel (errno %d)", client_number, errsv);
+                errno = errsv;
+                return -1;
+        }
+        return 0;
+}
+
+int server_socket::s_broadcast(const char* data, size_t length){
+        int sent = 0;
+        for (int i = 0; i < connections.size(); i++) {
+                if ( s_queue_message(connections.index_at(i), data, length) == 0 ) {
+                        sent++;
+                }
+        }
+        return sent;
+}
+
+// Send directly while nothing is queued (no copy), queue the rest
+int server_socket::s_reply(int client_number, uint64_t id, const char* data, size_t length){
+        if (connections[client_number].rx.framing != FRAMING_LENGTH_PREFIXED) {
+                // The binary id could contain the delimiter
+                errno = EPROTO;
+                return -1;
+        }
+        char prefix[RPC_ID_SIZE];
+        encode_rpc_id(id, prefix);
+        return s_queue_message(client_number, data, length, prefix, RPC_ID_SIZE);
+}
+
+// prefix (prefix_length bytes) goes out in front of data as part of the same message
+int server_socket::s_queue_message(int client_number, const char* data, size_t length, const char* prefix, size_t prefix_length){
+        connection& conn = connections[client_number];
+        if (conn.tx_blocked) {
+                errno = ENOBUFS;
+                return -1;
+        }
+        if (conn.rx_eof || conn.rx_error != 0) {
+                errno = EPIPE;
+                return -1;
+        }
+
+        static const char delim = '!';
+        char header[FRAME_HEADER_SIZE];
+        struct iovec iov[3];
+        int iovcnt = 0;
+        if (conn.rx.framing == FRAMING_LENGTH_PREFIXED) {
+                if (prefix_length + length > UINT32_MAX) {
+                        errno = EMSGSIZE;
+                        return -1;
+                }
+                encode_frame_header((uint32_t) (prefix_length + length), header);
+                iov[iovcnt].iov_base = header;
+                iov[iovcnt++].iov_len = FRAME_HEADER_SIZE;
+        }
+        if (prefix_length > 0) {
+                iov[iovcnt].iov_base = (void*) prefix;
+                iov[iovcnt++].iov_len = prefix_length;
+        }
+        iov[iovcnt].iov_base = (void*) data;
+        iov[iovcnt++].iov_len = length;
+        if (conn.rx.framing != FRAMING_LENGTH_PREFIXED) {
+                iov[iovcnt].iov_base = (void*) &delim;
+                iov[iovcnt++].iov_len = 1;
+        }
+
+        long num_bytes = 0;
+        conn.stats.messages_out++;
+        RSOCKET_COUNT(METRIC_MESSAGES_OUT, 1);
+        conn.last_write = s_now;
+        if ( conn.tx.empty() ) {
+                conn.last_progress = s_now;
+        }
+        if ( conn.tx.empty() && !s_uring ) {
+                num_bytes = send_iov_once(conn.fd, iov, iovcnt, 0);
+                conn.stats.bytes_out += (uint64_t) std::max(num_bytes, 0L);
+                if (num_bytes < 0) {
+                        // Let the read side report the broken connection
+                        int errsv = errno;
+                        s_set_hangup(conn.fd);
+                        errno = errsv;
+                        return -1;
+                }
+        }
+        // Anything the kernel didn't take goes out on the next EPOLLOUT edge (or io_uring send)
+        conn.tx.append(iov, iovcnt, (size_t) num_bytes);
+        if ( conn.tx.size() >= s_write_high_watermark ) {
+                conn.tx_blocked = true;
+        }
+        if (s_uring) {
+                s_uring_send(client_number);
+        }
+        if ( s_write_deadline > 0 && !conn.tx.empty() ) {
+                s_arm(client_number, TIMER_WRITE, conn.write_timer, (uint64_t) s_write_deadline);
+        }
+        return 0;
+}
+
+long server_socket::s_flush(int client_number){
+        connection& conn = connections[client_number];
+        if (s_uring) {
+                s_uring_send(client_number);
+                return 0;
+        }
+        long num_bytes = conn.tx.flush(conn.fd);
+        conn.stats.bytes_out += (uint64_t) std::max(num_bytes, 0L);
+        if (num_bytes < 0) {
+                int errsv = errno;
+                conn.tx.clear();
+                s_set_hangup(conn.fd);
+                errno = errsv;
+                return -1;
+        }
+        if (num_bytes > 0) {
+                conn.last_progress = s_now;
+        }
+        if ( conn.tx_blocked && conn.tx.size() <= s_write_low_watermark ) {
+                conn.tx_blocked = false;
+        }
+        return num_bytes;
+}
+
+bool server_socket::s_writable(int client_number){
+        return !connections[client_number].tx_blocked;
+}
+
+size_t server_socket::s_queued(int client_number){
+        return connections[client_number].tx.size();
 }
 
 long server_socket::socket_read(int client_number){
         long num_bytes = s_read(client_number);
         if ( num_bytes < 0 ) {
                 int errsv = errno;
-                std::cout << "Error reading from socket!" << std::endl;
-                std::cout << "Errno: " << errsv << std::endl;
+                // Nothing left to read, not an error on a non-blocking socket
+                if (errsv == EAGAIN || errsv == EWOULDBLOCK) {
+                        return -1;
+                }
+                RSOCKET_LOG_ERROR("Error reading from socket! (errno %d)", errsv);
                 return -1;
         } else if ( num_bytes > 0 ) {
-                std::cout << num_bytes << " bytes read from socket: " << std::endl;
-                for (int i=0; i < num_bytes; i++) {
-                        std::cout << socket_read_buffer[i];
-                }
-                std::cout << std::endl;
+                RSOCKET_LOG_TRACE("%ld bytes read from socket: %.*s", num_bytes, (int) num_bytes, socket_read_buffer);
                 return num_bytes;
         } else {
                 return 0;
         }
 }
 
+// Read whatever the client has sent into its receive buffer
+// One read per call so a fast sender can't starve the others, the client stays readable until drained
+long server_socket::s_read_frames(int client_number){
+        int fd = connections[client_number].fd;
+        recv_buffer& buffer = connections[client_number].rx;
+        s_picked_up(connections[client_number]);
+
+        if (s_uring) {
+                // io_uring already appended to the buffer, report what arrived since the last call
+                connection& conn = connections[client_number];
+                long num_bytes = (long) conn.rx_new;
+                conn.rx_new = 0;
+                s_set_readable(fd, false);
+                if (num_bytes > 0) {
+                        conn.stats.bytes_in += (uint64_t) num_bytes;
+                        conn.last_read = s_now;
+                        return num_bytes;
+                }
+                if (conn.rx_error != 0) {
+                        errno = conn.rx_error;
+                        return -1;
+                }
+                if (conn.rx_eof) {
+                        return 0;
+                }
+                errno = EAGAIN;
+                return -1;
+        }
+
+        if (connections[client_number].rx_error != 0) {
+                // Timed out, the socket itself may still be fine
+                errno = connections[client_number].rx_error;
+                return -1;
+        }
+        long num_bytes = buffer.fill(fd);
+        int errsv = errno;
+        if (num_bytes > 0) {
+                connections[client_number].stats.bytes_in += (uint64_t) num_bytes;
+                connections[client_number].last_read = s_now;
+        }
+        if ( num_bytes == 0 ) {
+                // EOF is sticky, keep reporting the client until it is removed
+                s_fd_readable[fd] |= FD_HUP;
+        } else if ( buffer.last_read_short() ) {
+                s_set_readable(fd, false);
+        }
+        errno = errsv;
+        return num_bytes;
+}
+
+bool server_socket::next_frame(int client_number, frame_view& frame){
+        connection& conn = connections[client_number];
+        if ( !conn.rx.next_frame(frame) ) {
+                // Part of a message is buffered, the rest has s_read_deadline to arrive
+                if ( s_read_deadline > 0 && conn.rx.size() > 0 ) {
+                        s_arm(client_number, TIMER_READ, conn.read_timer, (uint64_t) s_read_deadline);
+                }
+                return false;
+        }
+        conn.stats.messages_in++;
+        s_timers.cancel(conn.read_timer);
+        return true;
+}
+
+// Readiness latched by s_set_readable() has reached a handler
+void server_socket::s_picked_up(connection& conn){
+#if RSOCKET_METRICS
+        if (conn.ready_at != 0) {
+                RSOCKET_OBSERVE(METRIC_READY_TO_HANDLER_US, metrics_now_us() - conn.ready_at);
+                conn.ready_at = 0;
+        }
+#else
+        (void) conn;
+#endif
+}
+
+int server_socket::s_connection_stats(int client_number, connection_stats& stats){
+        if ( !connections.contains(client_number) ) {
+                errno = EINVAL;
+                return -1;
+        }
+        stats = connections[client_number].stats;
+        return 0;
+}
+
 // Splits comma delimited data from the socket buffer into a vector of strings
 // Seperates messages via message delimiter '!'
 std::vector<std::string> server_socket::splitBuffer(int& start){
+        std::vector<frame_view> fields;
+        splitBuffer(start, fields);
 
-        std::string temp_string;
         std::vector<std::string> data_strings;
+        data_strings.reserve(fields.size());
+        for (auto& field : fields) {
+                data_strings.emplace_back(field.data, field.size);
+        }
+        return data_strings;
+}
 
-        // Debug
-        std::cout << "Message:";
-
-        char next_char = '0';
-        // Put data into vector, stop on '!' or null terminator
-        while (next_char != '!' && next_char != '\0') {
-                next_char = socket_read_buffer[start];
-                if (next_char == ',' || next_char == '!') {
-                        data_strings.push_back(temp_string);
-                        // Debug
-                        std::cout << " " << temp_string;
-                        temp_string = "";
-                } else {
-                        temp_string += next_char;
+// Same as above, but fields are views into socket_read_buffer and the fields vector is reused
+// A message cut short by '\0' (or the end of the buffer) drops its unterminated last field
+size_t server_socket::splitBuffer(int& start, std::vector<frame_view>& fields){
+        fields.clear();
+        if ( socket_read_buffer == nullptr || start < 0 || start >= socket_read_buffer_size ) {
+                return 0;
+        }
+
+        uint32_t offsets[SPLIT_SCAN_BATCH];
+        const char* message = socket_read_buffer + start;
+        size_t remaining = (size_t) (socket_read_buffer_size - start);
+        size_t field_start = 0;
+        size_t position = 0;
+        while (position < remaining) {
+                size_t found = scan_delimiters(message + position, remaining - position, offsets, SPLIT_SCAN_BATCH);
+                for (size_t i = 0; i < found; i++) {
+                        size_t offset = position + offsets[i];
+                        char delimiter = message[offset];
+                        if (delimiter == '\0') {
+                                start += (int) offset + 1;
+                                return fields.size();
+                        }
+                        fields.push_back(frame_view{message + field_start, offset - field_start});
+                        field_start = offset + 1;
+                        if (delimiter == '!') {
+                                start += (int) offset + 1;
+                                return fields.size();
+                        }
+                }
+                if (found < SPLIT_SCAN_BATCH) {
+                        break;
                 }
-                start++;
+                position += (size_t) offsets[SPLIT_SCAN_BATCH - 1] + 1;
         }
 
-        // Debug
-        std::cout << " " << temp_string << std::endl;
+        // Ran off the end of the buffer
+        start = socket_read_buffer_size + 1;
+        return fields.size();
+}
 
-        return data_strings;
+// Split every complete message in the first num_bytes of socket_read_buffer at once
+size_t server_socket::split_messages(long num_bytes, std::vector<frame_view>& fields, std::vector<size_t>& message_ends){
+        if (num_bytes <= 0 || socket_read_buffer == nullptr) {
+                fields.clear();
+                message_ends.clear();
+                return 0;
+        }
+        size_t length = std::min((size_t) num_bytes, (size_t) socket_read_buffer_size);
+        split_block(frame_view{socket_read_buffer, length}, fields, message_ends);
+        return message_ends.size();
 }
 
-int server_socket::accept_pending_clients(){
-        // Create fd_set of clients for select()
-        fd_set socket_set;
-        int select_result;
-        int err;
-
-        // Wait for 100ms on select() calls
-        struct timeval delay = {0};
-        delay.tv_sec = 0;
-        delay.tv_usec = 100;
-
-        // Initialize set
-        FD_ZERO(&socket_set);
-        // Add server socket to socket settings
-        FD_SET(s_sockfd, &socket_set);
-
-        select_result = select(s_sockfd + 1, &socket_set, nullptr, nullptr, &delay);
-        err = errno;
-
-    if ( FD_ISSET(s_sockfd, &socket_set ) ){
-                // Attempt to accept client connection
-                if ( s_accept() < 0 ) {
-                        int errsv = errno;
-                        std::cout << "Failed to accept client connection" << std::endl;
-                        std::cout << "Errno: " << errsv << std::endl;
+//-----------------------------
+// io_uring engine
+//-----------------------------
+
+int server_socket::s_uring_init(){
+        s_uring.reset(new uring_engine());
+        if ( s_uring->init(DEFAULT_URING_ENTRIES, DEFAULT_URING_RECV_BUFFERS, DEFAULT_URING_RECV_BUFFER_SIZE,
+                           DEFAULT_URING_SEND_BUFFERS, DEFAULT_URING_SEND_BUFFER_SIZE) < 0
+             || s_uring->arm_accept(s_sockfd, uring_data(URING_OP_ACCEPT, 0, 0)) < 0 ) {
+                int errsv = errno;
+                s_uring.reset();
+                errno = errsv;
+                return -1;
+        }
+        s_send_owner.assign(DEFAULT_URING_SEND_BUFFERS, client_handle{0, 0});
+        return 0;
+}
+
+int server_socket::s_uring_poll(int timeout){
+        int n = s_uring->wait(timeout, s_completions);
+        if (n < 0) {
+                return (errno == EINTR) ? 0 : -1;
+        }
+        for (auto& completion : s_completions) {
+                s_uring_completion(completion);
+        }
+        return n;
+}
+
+void server_socket::s_uring_completion(const uring_completion& completion){
+        uint64_t op = completion.user_data >> 56;
+        uint32_t tag = (uint32_t) (completion.user_data >> 32) & 0xFFFFFF;
+        uint32_t index = (uint32_t) completion.user_data;
+        bool more = (completion.flags & IORING_CQE_F_MORE) != 0;
+
+        if (op == URING_OP_ACCEPT) {
+                if (completion.res >= 0) {
+                        s_accepted.push_back(completion.res);
+                        s_accept_ready = true;
+                } else if (completion.res != -ECANCELED) {
+                        RSOCKET_LOG_ERROR("Failed to accept client connection (errno %d)", -completion.res);
+                }
+                // Multishot ends on errors or overflow, keep accepting
+                if (!more) {
+                        s_uring->arm_accept(s_sockfd, uring_data(URING_OP_ACCEPT, 0, 0));
+                }
+                return;
+        }
+
+        if (op == URING_OP_RECV) {
+                // A completion can still arrive for a client that was removed (or whose number was reused)
+                bool live = connections.contains((int) index) && (connections.handle((int) index).generation & 0xFFFFFF) == tag;
+                connection* conn = live ? &connections[(int) index] : nullptr;
+
+                if (completion.flags & IORING_CQE_F_BUFFER) {
+                        unsigned bid = completion.flags >> IORING_CQE_BUFFER_SHIFT;
+                        if (conn != nullptr && completion.res > 0) {
+                                if ( conn->rx.append(s_uring->recv_buffer(bid), (size_t) completion.res) ) {
+                                        conn->rx_new += (size_t) completion.res;
+                                } else {
+                                        conn->rx_error = EMSGSIZE;
+                                }
+                                s_set_readable(conn->fd, true);
+                        }
+                        // Copied out, give the buffer straight back to the kernel
+                        s_uring->recycle(bid);
+                }
+                if (conn == nullptr) {
+                        return;
+                }
+
+                if (completion.res == 0) {
+                        conn->rx_eof = true;
+                        s_set_hangup(conn->fd);
+                } else if (completion.res < 0 && completion.res != -ENOBUFS && completion.res != -ECANCELED) {
+                        conn->rx_error = -completion.res;
+                        s_set_hangup(conn->fd);
+                }
+                // Multishot stops when it runs out of provided buffers, re-arm unless the connection is done
+                if ( !more && !conn->rx_eof && conn->rx_error == 0 && completion.res != -ECANCELED ) {
+                        s_uring->arm_recv(conn->fd, completion.user_data);
+                }
+                return;
+        }
+
+        if (op == URING_OP_SEND) {
+                int buffer_index = (int) tag;
+                // Zero copy sends complete twice, the buffer is only free again after the notification
+                bool release = (completion.flags & IORING_CQE_F_NOTIF) != 0 || !more;
+
+                client_handle owner = s_send_owner[buffer_index];
+                if ( !(completion.flags & IORING_CQE_F_NOTIF) && connections.valid(owner) ) {
+                        int client_number = (int) owner.index;
+                        connection& conn = connections[client_number];
+                        conn.tx_buffer = -1;
+                        if (completion.res == -EOPNOTSUPP && s_uring->send_zerocopy) {
+                                // Socket type without zero copy support, send copies from now on
+                                s_uring->send_zerocopy = false;
+                                s_uring_send(client_number);
+                        } else if (completion.res > 0) {
+                                conn.tx.consume((size_t) completion.res);
+                                conn.stats.bytes_out += (uint64_t) completion.res;
+                                conn.last_progress = s_now;
+                                RSOCKET_COUNT(METRIC_BYTES_OUT, completion.res);
+                                if ( conn.tx_blocked && conn.tx.size() <= s_write_low_watermark ) {
+                                        conn.tx_blocked = false;
+                                }
+                                s_uring_send(client_number);
+                        } else if (completion.res != -ECANCELED) {
+                                conn.tx.clear();
+                                conn.rx_error = (completion.res < 0) ? -completion.res : EPIPE;
+                                s_set_hangup(conn.fd);
+                        }
+                }
+                if (!release) {
+                        return;
+                }
+                s_uring->release_send_buffer(buffer_index);
+
+                // Buffer freed, let a waiting client have it
+                while ( !s_send_waiting.empty() ) {
+                        client_handle waiting = s_send_waiting.back();
+                        s_send_waiting.pop_back();
+                        if ( connections.valid(waiting) ) {
+                                s_uring_send((int) waiting.index);
+                                break;
+                        }
+                }
+        }
+}
+
+// Copy the head of the client's queue into a registered buffer and send it, one send in flight per client
+void server_socket::s_uring_send(int client_number){
+        connection& conn = connections[client_number];
+        if ( conn.tx_buffer >= 0 || conn.tx.empty() ) {
+                return;
+        }
+        int buffer_index = s_uring->acquire_send_buffer();
+        if (buffer_index < 0) {
+                s_send_waiting.push_back(connections.handle(client_number));
+                return;
+        }
+
+        size_t length = conn.tx.peek(s_uring->send_buffer(buffer_index), s_uring->send_size);
+        if (length == 0) {
+                // Only a queued file that can no longer be read
+                int errsv = errno;
+                s_uring->release_send_buffer(buffer_index);
+                conn.tx.clear();
+                conn.rx_error = errsv != 0 ? errsv : EIO;
+                s_set_hangup(conn.fd);
+                return;
+        }
+        s_send_owner[buffer_index] = connections.handle(client_number);
+        conn.tx_buffer = buffer_index;
+        s_uring->send_fixed(conn.fd, buffer_index, (unsigned) length, uring_data(URING_OP_SEND, (uint32_t) buffer_index, (uint32_t) client_number));
+}
+
+//-----------------------------
+// Connection timers
+//-----------------------------
+// Activity only stamps the connection (last_read / last_write / last_progress), it never touches the wheel.
+// An idle / heartbeat / write timer that fires after some activity just re-arms for the rest of the period,
+// so a busy client costs one timer operation per period instead of one per message
+
+void server_socket::s_arm(int client_number, uint64_t kind, timer_handle& timer, uint64_t delay){
+        if ( !s_timers.active(timer) ) {
+                timer = s_timers.schedule(delay, timer_cookie(kind, connections.handle(client_number).generation, (uint32_t) client_number));
+        }
+}
+
+void server_socket::s_start_timers(int client_number){
+        connection& conn = connections[client_number];
+        conn.last_read = s_now;
+        conn.last_write = s_now;
+        conn.last_progress = s_now;
+        if (s_idle_timeout > 0) {
+                s_arm(client_number, TIMER_IDLE, conn.idle_timer, (uint64_t) s_idle_timeout);
+        }
+        if (s_heartbeat_interval > 0) {
+                s_arm(client_number, TIMER_HEARTBEAT, conn.heartbeat_timer, (uint64_t) s_heartbeat_interval);
+        }
+}
+
+void server_socket::s_stop_timers(connection& conn){
+        s_timers.cancel(conn.idle_timer);
+        s_timers.cancel(conn.read_timer);
+        s_timers.cancel(conn.write_timer);
+        s_timers.cancel(conn.heartbeat_timer);
+}
+
+void server_socket::s_timer_expired(uint64_t cookie){
+        uint64_t kind = cookie >> 56;
+        uint32_t tag = (uint32_t) (cookie >> 32) & 0xFFFFFF;
+        int client_number = (int) (uint32_t) cookie;
+        // Timers are canceled with their client, this only guards against a reused client number
+        if ( !connections.contains(client_number) || (connections.handle(client_number).generation & 0xFFFFFF) != tag ) {
+                return;
+        }
+        connection& conn = connections[client_number];
+
+        if (kind == TIMER_IDLE) {
+                uint64_t idle = s_now - std::max(conn.last_read, conn.last_write);
+                if ( idle >= (uint64_t) s_idle_timeout ) {
+                        RSOCKET_LOG_DEBUG("Client %d idle for %llu ms", client_number, (unsigned long long) idle);
+                        s_timed_out(client_number);
+                } else {
+                        s_arm(client_number, TIMER_IDLE, conn.idle_timer, (uint64_t) s_idle_timeout - idle);
+                }
+        } else if (kind == TIMER_READ) {
+                if ( conn.rx.size() > 0 ) {
+                        RSOCKET_LOG_DEBUG("Client %d missed its read deadline (%zu bytes of a message buffered)", client_number, conn.rx.size());
+                        s_timed_out(client_number);
+                }
+        } else if (kind == TIMER_WRITE) {
+                if ( conn.tx.empty() ) {
+                        return;
+                }
+                uint64_t stalled = s_now - conn.last_progress;
+                if ( stalled >= (uint64_t) s_write_deadline ) {
+                        RSOCKET_LOG_DEBUG("Client %d missed its write deadline (%zu bytes queued)", client_number, conn.tx.size());
+                        s_timed_out(client_number);
                 } else {
-                        std::cout << "Accepted new client connection" << std::endl;
-                        std::cout << std::endl;
+                        s_arm(client_number, TIMER_WRITE, conn.write_timer, (uint64_t) s_write_deadline - stalled);
+                }
+        } else if (kind == TIMER_HEARTBEAT) {
+                uint64_t quiet = s_now - conn.last_write;
+                if ( quiet >= (uint64_t) s_heartbeat_interval ) {
+                        // Not activity as far as the idle timeout is concerned
+                        uint64_t last_write = conn.last_write;
+                        if ( s_queue_message(client_number, s_heartbeat_message.data(), s_heartbeat_message.size()) == 0 ) {
+                                conn.last_write = last_write;
+                        }
+                        quiet = 0;
+                }
+                // The send may have broken the connection, stop sending heartbeats then
+                if ( conn.rx_error == 0 && !conn.rx_eof ) {
+                        s_arm(client_number, TIMER_HEARTBEAT, conn.heartbeat_timer, (uint64_t) s_heartbeat_interval - quiet);
                 }
         }
+}
 
-        if (err == EWOULDBLOCK) {
-                return select_result;
-        } else {
-                return err;
+void server_socket::s_timed_out(int client_number){
+        connection& conn = connections[client_number];
+        if (conn.rx_error == 0) {
+                conn.rx_error = ETIMEDOUT;
         }
+        s_stop_timers(conn);
+        s_set_hangup(conn.fd);
+        RSOCKET_COUNT(METRIC_TIMEOUTS, 1);
 }
 
-std::vector<int> server_socket::check_client_buffers(){
-        // Create fd_set of clients for select()
-        fd_set socket_set;
-        int select_result;
-        int err;
+//-----------------------------
 
-        // Wait for 100ms on select() calls
-        struct timeval delay = {0};
-        delay.tv_sec = 0;
-        delay.tv_usec = 100;
+int server_socket::accept_pending_clients(){
+        // Don't sleep if the listener still has connections queued from an earlier edge
+        int poll_result = s_poll(s_accept_ready ? 0 : s_idle_wait());
+        if (poll_result < 0) {
+                return errno;
+        }
 
-        // Result vector. Returns -1,err on error, 0 on timeout, and 1,fd,fd,... for ready fds
-        std::vector<int> results;
+        if (s_accept_ready) {
+                // Drain the listen queue (up to s_accept_limit clients)
+                int accepted = s_accept_all();
+                if (accepted > 0) {
+                        RSOCKET_LOG_DEBUG("Accepted %d new client connection(s)", accepted);
+                }
+        }
+
+        return poll_result;
+}
+
+//-----------------------------
+// Datagram sockets
+//-----------------------------
+
+bool server_socket::s_is_datagram(){
+        return (s_type & ~(SOCK_NONBLOCK | SOCK_CLOEXEC)) == SOCK_DGRAM;
+}
 
-        // Check for data on each client socket
-                // Initialize set
-                FD_ZERO(&socket_set);
-                // Add clients to socket_set;
-                for (auto i : client_list) {
-                        FD_SET(i, &socket_set);
+long server_socket::s_recv_datagrams(std::vector<datagram>& datagrams){
+        datagrams.clear();
+        long received = s_datagrams.receive(s_sockfd, datagrams);
+        if (received < 0) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                        // Drained, wait for the next edge
+                        s_accept_ready = false;
+                        return 0;
                 }
+                int errsv = errno;
+                RSOCKET_LOG_ERROR("Failed to receive datagrams (errno %d)", errsv);
+                errno = errsv;
+                return -1;
+        }
+        return received;
+}
 
-                int max_fd = max_client_fd();
+bool server_socket::s_datagrams_pending(){
+        return s_is_datagram() && s_accept_ready;
+}
 
-                // select(max fd + 1, read socket_set, write socket_set, except socket_set, timeout)
-                select_result = select(max_fd + 1, &socket_set, nullptr, nullptr, &delay);
-                err = errno;
+long server_socket::s_send_datagrams(const datagram* datagrams, size_t count){
+        long sent = send_datagrams(s_sockfd, datagrams, count);
+        if (sent < 0) {
+                int errsv = errno;
+                RSOCKET_LOG_ERROR("Failed to send datagrams (errno %d)", errsv);
+                errno = errsv;
+        }
+        return sent;
+}
+
+int server_socket::s_reply_datagram(const datagram& received, const char* data, size_t length){
+        datagram reply = received;
+        reply.data = data;
+        reply.size = length;
+        return s_send_datagrams(&reply, 1) == 1 ? 0 : -1;
+}
+
+long server_socket::s_send_segments(const datagram& peer, const char* data, size_t length, size_t segment_size){
+        long sent = send_segments(s_sockfd, data, length, segment_size, (const struct sockaddr*) &peer.peer, peer.peer_len);
+        if (sent < 0) {
+                int errsv = errno;
+                RSOCKET_LOG_ERROR("Failed to send datagrams (errno %d)", errsv);
+                errno = errsv;
+        }
+        return sent;
+}
+
+int server_socket::s_enable_gro(){
+        if ( enable_gro(s_sockfd) < 0 ) {
+                int errsv = errno;
+                RSOCKET_LOG_WARN("UDP_GRO unavailable (errno %d)", errsv);
+                errno = errsv;
+                return -1;
+        }
+        // Slots have to hold a whole coalesced receive now
+        s_datagrams.release();
+        s_datagrams.batch_size = DATAGRAM_GRO_BATCH_SIZE;
+        s_datagrams.slot_size = DATAGRAM_GRO_SLOT_SIZE;
+        return 0;
+}
+
+//-----------------------------
+
+bool server_socket::s_accept_pending(){
+        return s_accept_ready;
+}
+
+// Collect readable clients, dropping fds that have been drained or removed
+size_t server_socket::s_ready_clients(std::vector<int>& clients){
+        size_t kept = 0;
+        for (size_t i = 0; i < s_readable_fds.size(); i++) {
+                int fd = s_readable_fds[i];
+                if ( !(s_fd_readable[fd] & FD_READABLE) || s_fd_client[fd] < 0 ) {
+                        s_fd_readable[fd] = 0;
+                        continue;
+                }
+                s_readable_fds[kept++] = fd;
+                clients.push_back(s_fd_client[fd]);
+        }
+        s_readable_fds.resize(kept);
+        return kept;
+}
+
+std::vector<int> server_socket::check_client_buffers(){
+        // Result vector. Returns -1,err on error, 0 on timeout, and 1,client,client,... for ready clients
+        std::vector<int> results;
+
+        // Don't sleep if clients still have unread data from an earlier edge
+        int poll_result = s_poll(s_readable_fds.empty() ? s_idle_wait() : 0);
 
         // Something went wrong
-        if (select_result < 0){
+        if (poll_result < 0){
                 results.push_back(-1);
-                results.push_back(err);
+                results.push_back(errno);
                 return results;
-        } else if (select_result > 0) {
-                results.push_back(1);
-                // Check which client sockets are readable
-                int desc_ready = select_result;
-                for (int i = 0; i < (int) client_list.size() && desc_ready > 0; i++) {
-                        if (FD_ISSET(client_list[i], &socket_set)) {
-                                // Client socket has data to read
-                                desc_ready--;
-                                results.push_back(i);
-                        }
-                }
+        }
+
+        results.push_back(1);
+        if ( s_ready_clients(results) > 0 ) {
+                // Ascending like the old select() scan, so callers can remove clients walking backwards
+                std::sort(results.begin() + 1, results.end());
                 return results;
         }
+
         // No socket has pending data
+        results.clear();
         results.push_back(0);
         return results;
 }
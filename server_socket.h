@@ -27,12 +27,33 @@
 #define DEFAULT_PROTOCOL 0
 // Default bind address (localhost)
 #define DEFAULT_BIND_ADDRESS INADDR_ANY
+// Backlog value meaning "as many as the system allows" (net.core.somaxconn)
+#define BACKLOG_SOMAXCONN -1
 // Default max # of pending client connections on inet socket
 // NOTE: Pending clients are clients who are trying to connect but have not been accepted yet,
-//       this is not a limit on the number of active clients
-#define DEFAULT_BACKLOG 4
+//       this is not a limit on the number of active clients. A short queue drops connection attempts
+//       (SYN drops, client retries after a second or more) as soon as many clients connect at once
+#define DEFAULT_BACKLOG BACKLOG_SOMAXCONN
+// Default max # of clients accepted per accept_pending_clients() / s_accept_all() call, the rest wait for
+// the next loop iteration so a reconnect storm doesn't starve clients that are already connected
+#define DEFAULT_ACCEPT_LIMIT 64
 // Default socket buffer size
 #define DEFAULT_SOCKET_BUFFER_SIZE 4096
+// Default max # of events returned by a single epoll_wait()
+#define DEFAULT_MAX_EVENTS 256
+// Default event loop wait (ms) used by accept_pending_clients() / check_client_buffers() (s_poll_timeout)
+#define DEFAULT_POLL_TIMEOUT 1
+// Default wait strategy, see wait_strategy below
+#define DEFAULT_WAIT_STRATEGY WAIT_TIMED
+// WAIT_ADAPTIVE: default time (µs) to keep spinning after the last event before blocking
+#define DEFAULT_SPIN_USECS 100
+// WAIT_BUSY_POLL: default SO_BUSY_POLL (µs) for the listener and its clients
+#define DEFAULT_BUSY_POLL_USECS 50
+// Default connection timers (ms), 0 = off. See s_idle_timeout / s_read_deadline / s_write_deadline / s_heartbeat_interval
+#define DEFAULT_IDLE_TIMEOUT 0
+#define DEFAULT_READ_DEADLINE 0
+#define DEFAULT_WRITE_DEADLINE 0
+#define DEFAULT_HEARTBEAT_INTERVAL 0
 //-----------------------------
 
 // Includes
@@ -44,12 +65,52 @@
 #include <unistd.h>
 #include <sys/ioctl.h>
 #include <algorithm>
+#include <deque>
+#include <memory>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <sys/stat.h>
 // Socket / inet libraries
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
+// Event notification
+#include <sys/epoll.h>
+
+#include "logger.h"
+#include "metrics.h"
+#include "connection.h"
+#include "connection_table.h"
+#include "datagram.h"
+#include "buffer_pool.h"
+#include "recv_buffer.h"
+#include "scan.h"
+#include "shm_channel.h"
+#include "socket_options.h"
+#include "timer_wheel.h"
+#include "uring_engine.h"
 //-----------------------------
 
+// How s_poll() waits for events
+// Spinning trades a core for not paying a sleep / wake-up per event, only worth it when latency matters
+enum wait_strategy
+{
+        // Sleep in epoll_wait() / io_uring_enter() for the whole timeout
+        WAIT_TIMED = 0,
+        // Like WAIT_TIMED, but accept_pending_clients() / check_client_buffers() sleep until an event arrives
+        // (s_poll() callers passing their own timeout are unaffected)
+        WAIT_BLOCKING = 1,
+        // Never sleep: poll without a timeout until something happens or the timeout runs out
+        // Also sets SO_BUSY_POLL so the kernel polls the NIC queue for our sockets (needs CAP_NET_ADMIN above
+        // net.core.busy_read, the spinning still happens without it)
+        WAIT_BUSY_POLL = 2,
+        // Spin while traffic is flowing, sleep once nothing happened for s_spin_usecs
+        WAIT_ADAPTIVE = 3
+};
+
 // Allows storage of parameters for socket functions
 // Also handles creation and configuration of sockaddr_in struct
 // TODO: Add asynchronous read loop
@@ -57,13 +118,100 @@ class server_socket
 {
     private:
         // Socket file descriptor
-        int s_sockfd = 0;
+        int s_sockfd = -1;
 
-    public:
+        // epoll instance, listener and clients are registered once (edge-triggered)
+        int s_epollfd = -1;
+        // Scratch array for epoll_wait()
+        std::vector<struct epoll_event> s_events;
+        // Listener reported readable and accept() has not hit EAGAIN yet
+        // (datagram socket: datagrams are waiting for s_recv_datagrams())
+        bool s_accept_ready = false;
+        // Per-fd state, indexed by fd: readable / queued / hangup flags and client number
+        std::vector<char> s_fd_readable;
+        std::vector<int> s_fd_client;
+        // Fds flagged readable (may contain stale entries, compacted in check_client_buffers())
+        std::vector<int> s_readable_fds;
+
+        // Register fd with epoll and track it in the per-fd tables
+        int s_register(int fd, uint32_t events);
+        void s_track(int fd);
+        void s_set_readable(int fd, bool readable);
+
+        // Connected clients (fd, receive buffer, output queue), indexed by client number
+        connection_table connections;
+
+        // Frame data (after an optional prefix) for the client and send / queue it
+        int s_queue_message(int client_number, const char* data, size_t length,
+                            const char* prefix = nullptr, size_t prefix_length = 0);
+        // Send queued output after the client became writable
+        long s_flush(int client_number);
+
+        // s_poll() without the loop metrics
+        int s_poll_events(int timeout);
+        // s_poll_events() according to s_wait
+        int s_wait_events(int timeout);
+        // When the last s_poll_events() found something (metrics_now_us()), for WAIT_ADAPTIVE
+        uint64_t s_last_event = 0;
+        // Idle wait of accept_pending_clients() / check_client_buffers()
+        int s_idle_wait();
+        // When s_poll() last returned (metrics_now_us()), for METRIC_LOOP_ITERATION_US
+        uint64_t s_poll_returned = 0;
+        // Record METRIC_READY_TO_HANDLER_US for a client about to be read
+        void s_picked_up(connection& conn);
+
+        // io_uring engine, only set while it is the active engine
+        std::unique_ptr<uring_engine> s_uring;
+        std::vector<uring_completion> s_completions;
+        // Sockets completed by multishot accept, handed out by s_accept()
+        std::deque<int> s_accepted;
+        // Owner of each registered send buffer in flight
+        std::vector<client_handle> s_send_owner;
+        // Clients with queued output waiting for a free registered send buffer
+        std::vector<client_handle> s_send_waiting;
+
+        // s_type is SOCK_DGRAM
+        bool s_is_datagram();
+        // Receive slots of a datagram socket, leased by the first s_recv_datagrams()
+        datagram_batch s_datagrams;
+
+        // Per-connection socket options, applied as each client is accepted
+        void s_client_options(int fd);
+
+        // s_bind() for AF_UNIX
+        int s_bind_unix();
+        // Socket file s_bind_unix() created, unlinked by s_release()
+        std::string s_bound_path;
 
-        // FIXME: Make this private and have server_socket keep track of its own clients
-        // Connected clients list
-        std::vector<int> client_list;
+        // Capacity of the leased socket_read_buffer
+        size_t s_read_capacity = 0;
+        // Lease socket_read_buffer if needed
+        char* s_read_scratch();
+        // Give back everything the server owns
+        void s_release();
+
+        int s_uring_init();
+        int s_uring_poll(int timeout);
+        void s_uring_completion(const uring_completion& completion);
+        void s_uring_send(int client_number);
+        // Report a broken connection through the read side
+        void s_set_hangup(int fd);
+
+        // Per-connection timers, advanced by s_poll(). Cookies carry the timer kind and the client's handle
+        timer_wheel s_timers;
+        std::vector<uint64_t> s_expired;
+        // timer_now_ms() as of the last s_poll(), activity stamps and timers use it instead of reading the clock
+        uint64_t s_now = 0;
+        // Arm timer unless it is already running
+        void s_arm(int client_number, uint64_t kind, timer_handle& timer, uint64_t delay);
+        // Start the idle / heartbeat timers of a new client
+        void s_start_timers(int client_number);
+        void s_stop_timers(connection& conn);
+        void s_timer_expired(uint64_t cookie);
+        // Cut the client off, the read side reports ETIMEDOUT
+        void s_timed_out(int client_number);
+
+    public:
 
         // Port number
         uint16_t s_port;
@@ -76,11 +224,54 @@ class server_socket
         // Address to bind to (i.e., localhost)
         int s_bind_address;
         // How many clients can be waiting for a connection before new clients get rejected
+        // BACKLOG_SOMAXCONN uses the system limit, larger values are capped to it
         int backlog;
+        // Max clients accepted per accept_pending_clients() / s_accept_all() call
+        int s_accept_limit = DEFAULT_ACCEPT_LIMIT;
+        // Set TCP_NODELAY on every accepted TCP client (same as s_options.nodelay = 1)
+        bool s_nodelay = false;
+        // Socket tuning for the listener and accepted clients, e.g., socket_options::low_latency()
+        // Set before s_init(). s_options.busy_poll_usecs overrides s_busy_poll_usecs
+        socket_options s_options;
+        // Message framing used for new clients (FRAMING_AUTO lets each client choose via FRAME_PREAMBLE)
+        framing_mode s_framing = FRAMING_DELIMITED;
+        // Queued output (bytes) at which s_write() starts refusing a client
+        size_t s_write_high_watermark = DEFAULT_WRITE_HIGH_WATERMARK;
+        // A refused client accepts writes again once its queue drains below this
+        size_t s_write_low_watermark = DEFAULT_WRITE_LOW_WATERMARK;
+        // I/O engine to use, ENGINE_URING / ENGINE_AUTO fall back to epoll if io_uring is unavailable
+        io_engine s_engine = ENGINE_EPOLL;
+        // How s_poll() waits, see wait_strategy. Set before s_init() (WAIT_BUSY_POLL configures the listener)
+        wait_strategy s_wait = DEFAULT_WAIT_STRATEGY;
+        // Wait (ms) of accept_pending_clients() / check_client_buffers() when there is nothing to do
+        int s_poll_timeout = DEFAULT_POLL_TIMEOUT;
+        // WAIT_ADAPTIVE: keep spinning this long (µs) after the last event
+        int s_spin_usecs = DEFAULT_SPIN_USECS;
+        // WAIT_BUSY_POLL: SO_BUSY_POLL value (µs), accepted clients inherit it from the listener. 0 leaves it alone
+        int s_busy_poll_usecs = DEFAULT_BUSY_POLL_USECS;
+        // Connection timers (ms, 0 = off), they cost nothing while off and O(1) per client while on
+        // A client that timed out is reported readable and its reads fail with ETIMEDOUT, remove it as usual
+        // Close clients that neither sent nor were sent anything for this long
+        int s_idle_timeout = DEFAULT_IDLE_TIMEOUT;
+        // Time a client has to complete a message once part of it arrived
+        int s_read_deadline = DEFAULT_READ_DEADLINE;
+        // Time queued output may sit without the client reading any of it
+        int s_write_deadline = DEFAULT_WRITE_DEADLINE;
+        // Send s_heartbeat_message to clients we haven't sent anything for this long (keeps them and NATs
+        // in between from giving up on a quiet connection). Heartbeats don't count as activity for s_idle_timeout
+        int s_heartbeat_interval = DEFAULT_HEARTBEAT_INTERVAL;
+        // Heartbeat payload, framed like any other message
+        std::string s_heartbeat_message;
+        // AF_UNIX socket path (s_domain AF_UNIX, s_port is ignored), '@' at the start binds in the abstract namespace
+        // A stale socket file left at the path is replaced, and the file is removed again when the server goes away
+        std::string s_path;
+        // Set SO_REUSEPORT so several listeners (e.g., one per worker thread) can share s_port
+        bool s_reuseport = false;
 
-        // "Read" buffer
-        char* socket_read_buffer;
-        // "Read" buffer size
+        // "Read" buffer used by s_read() / socket_read(), leased from buffer_pool on the first read
+        // Reads are NUL terminated, so the lease is one byte larger than socket_read_buffer_size
+        char* socket_read_buffer = nullptr;
+        // "Read" buffer size (also the initial receive buffer size of each client)
         int socket_read_buffer_size;
 
         // netinet/in.h defined address struct
@@ -92,8 +283,31 @@ class server_socket
         //---------------------s_port, s_domain, s_type, s_protocol, s_bind_address, backlog, socket_read_buffer_size
         ~server_socket();
 
+        // Move-only, the listener, event loop and clients belong to one object
+        // (new members have to be added to the move assignment)
+        server_socket(const server_socket&) = delete;
+        server_socket& operator=(const server_socket&) = delete;
+        server_socket(server_socket&& other) noexcept;
+        server_socket& operator=(server_socket&& other) noexcept;
+
+        // Clients are identified by a client number that stays the same while the client is connected
+        // (numbers of removed clients are reused, get_client_handle() / client_valid() detect that)
         int client_count();
 
+        // Client number of the position-th connected client (0 <= position < client_count())
+        // Positions shift when clients are removed, client numbers don't
+        int client_at(int position);
+
+        // Socket of a client
+        int client_fd(int client_number);
+
+        // Client number for a socket returned by s_accept(), or -1
+        int fd_client(int fd);
+
+        // Handle that only matches this client, not a later client given the same number
+        client_handle get_client_handle(int client_number);
+        bool client_valid(client_handle handle);
+
         int s_init();
 
         // Returns file descriptor or -1
@@ -102,30 +316,132 @@ class server_socket
         // Setup socket for non-blocking select()
         int s_set_nonblocking();
 
+        // Bind to s_bind_address:s_port, or to s_path for AF_UNIX
         // Returns 0 or -1
         int s_bind();
 
         // Listen on port
         int s_listen();
 
-        // Accept client connection
+        // Largest backlog listen() honors (net.core.somaxconn)
+        static int s_max_backlog();
+
+        // Create epoll instance and register the listening socket
+        int s_epoll_init();
+
+        // Engine actually in use after s_init()
+        io_engine s_active_engine();
+
+        // Wait up to timeout ms (-1 = forever) for accept / read readiness, sleeping or spinning as s_wait says
+        // Returns number of events or -1
+        int s_poll(int timeout);
+
+        // Accept client connection (non-blocking, close-on-exec), returns its socket or -1 (EAGAIN once drained)
         int s_accept();
 
-        // Remove a client
-        int remove_client(int client_num);
+        // Accept until the listen queue is drained or s_accept_limit clients were accepted
+        // Returns the number accepted, s_accept_pending() stays true if the limit cut it short
+        int s_accept_all();
 
-        // Get largest client fd
-        int max_client_fd();
+        // Remove a client, O(1). Does not close its socket
+        int remove_client(int client_num);
 
         // Read from buffer
         long s_read(int);
 
+        // Broadcast a '\0' terminated message to all clients
         int s_write(char*);
 
+        // Send one message to a client, framed like the messages it sends us
+        // Whatever the socket won't take right now is queued and sent when the event loop sees it writable
+        // Returns 0, or -1 with errno ENOBUFS while the client's queue is above the high watermark
+        int s_write(int client_number, const char* data, size_t length);
+
+        // Answer an RPC request (see rpc_client.h) with the correlation id split_rpc_frame() found in it
+        // Same queueing as s_write(), the client must be length-prefixed (FRAMING_AUTO + negotiated, or
+        // FRAMING_LENGTH_PREFIXED), otherwise -1 with errno EPROTO
+        int s_reply(int client_number, uint64_t id, const char* data, size_t length);
+
+        // Send length bytes of file_fd from offset as one message, without copying them through user space
+        // (sendfile() / splice() from the event loop, see send_queue.h). file_fd is dup()ed, close it whenever
+        // With io_uring the range is read into the registered send buffers instead
+        // Same queueing and return values as s_write(), length-prefixed clients get EMSGSIZE above 4 GiB
+        // Receivers buffer whole messages, stream big files as a series of ranges
+        int s_send_file(int client_number, int file_fd, off_t offset, size_t length);
+
+        // Map the shared memory rings a same-host client offered (client_socket::c_open_shm()) into channel,
+        // waiting up to timeout ms for the offer. Call right after s_accept(), before reading from the client
+        // The client keeps its socket, a hangup there means the channel is dead too
+        // epoll engine only (io_uring receives would swallow the offer), 0 or -1 (EOPNOTSUPP, ETIMEDOUT, EPROTO, ...)
+        int s_accept_shm(int client_number, shm_channel& channel, int timeout = DEFAULT_SHM_ACCEPT_TIMEOUT);
+
+        // Send one message to every client that is not over its high watermark
+        // Returns the number of clients the message was sent or queued for
+        int s_broadcast(const char* data, size_t length);
+
+        // False while the client's output queue is above the high watermark (until it drains to the low one)
+        bool s_writable(int client_number);
+
+        // Bytes queued for the client
+        size_t s_queued(int client_number);
+
+        // Traffic counters of one client (library-wide totals are in metrics.h), 0 or -1 for an unknown client
+        int s_connection_stats(int client_number, connection_stats& stats);
+
         long socket_read(int client_number);
 
+        // Read from the client's socket into its own receive buffer, keeping partial messages across reads
+        // Returns bytes read, 0 on EOF, -1 on error (EAGAIN if nothing was pending)
+        long s_read_frames(int client_number);
+
+        // Get the next complete message buffered for the client, framed according to s_framing
+        // The view is valid until the next s_read_frames() for that client, or until next_frame() returns false
+        // for a client with nothing left buffered (an idle client's receive memory goes back to the pool then)
+        bool next_frame(int client_number, frame_view& frame);
+
+        // Split the message at socket_read_buffer[start] into comma delimited fields, start moves past the '!'
         std::vector<std::string> splitBuffer(int& start);
 
+        // Allocation free version, fields point into socket_read_buffer and the vector is reused between calls
+        size_t splitBuffer(int& start, std::vector<frame_view>& fields);
+
+        // Split all complete messages in the first num_bytes of socket_read_buffer in one vectorized pass
+        // See split_block() in framing.h, returns the number of messages
+        size_t split_messages(long num_bytes, std::vector<frame_view>& fields, std::vector<size_t>& message_ends);
+
+        // Datagram sockets (s_type SOCK_DGRAM): s_init() binds without listen() and there are no clients,
+        // s_poll() reports incoming datagrams through s_datagrams_pending(). Always uses the epoll engine
+
+        // Receive a batch of datagrams with one recvmmsg(), replacing the contents of datagrams
+        // Views point into pooled receive slots and stay valid until the next call
+        // Returns the number received, 0 once the socket is drained (wait for s_poll()), -1 on error
+        long s_recv_datagrams(std::vector<datagram>& datagrams);
+
+        // True while the socket reported readable and s_recv_datagrams() has not drained it yet
+        bool s_datagrams_pending();
+
+        // Send datagrams to their peers (e.g., copied from received ones), sendmmsg() batches
+        // Returns the number sent or -1
+        long s_send_datagrams(const datagram* datagrams, size_t count);
+
+        // Send one datagram back to the sender of received, 0 or -1
+        int s_reply_datagram(const datagram& received, const char* data, size_t length);
+
+        // Send length bytes to peer as datagrams of segment_size bytes, segmented by the kernel where possible (GSO)
+        // Returns the number of datagrams sent or -1
+        long s_send_segments(const datagram& peer, const char* data, size_t length, size_t segment_size);
+
+        // Receive coalesced datagrams (UDP_GRO) and switch the receive slots to the DATAGRAM_GRO_* sizes, 0 or -1
+        // Call after s_init()
+        int s_enable_gro();
+
+        // Append the numbers of clients with unread data (or a hangup) seen by earlier s_poll() calls
+        // Clients stay listed until a read drains them. Returns how many were appended
+        size_t s_ready_clients(std::vector<int>& clients);
+
+        // True while a listener edge has not been drained by s_accept()
+        bool s_accept_pending();
+
         int accept_pending_clients();
 
         std::vector<int> check_client_buffers();
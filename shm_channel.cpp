@@ -0,0 +1,429 @@
+//--------------------------
+// Shared memory channel module
+//--------------------------
+// Description:
+// Same-host message transport over two single producer / single consumer rings in shared memory
+// (memfd + mmap), with eventfd wakeups. Set up over a connected AF_UNIX socket (SCM_RIGHTS)
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#include "shm_channel.h"
+
+// Fds passed by offer(): memfd, data eventfd, space eventfd of the offerer's tx ring, then of its rx ring
+#define SHM_OFFER_FDS 6
+// Seals that keep the peer from resizing the memfd under our mapping (SIGBUS)
+#define SHM_SEALS (F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL)
+
+// Payload of the offer message, the fds travel as SCM_RIGHTS
+struct shm_offer
+{
+        uint32_t magic;
+        uint32_t reserved;
+};
+
+static size_t page_size(){
+        return (size_t) sysconf(_SC_PAGESIZE);
+}
+
+//-----------------------------
+// Class: shm_channel
+//-----------------------------
+
+shm_channel::~shm_channel(){
+        close();
+}
+
+shm_channel::shm_channel(shm_channel&& other) noexcept {
+        *this = std::move(other);
+}
+
+shm_channel& shm_channel::operator=(shm_channel&& other) noexcept {
+        if (this != &other) {
+                close();
+                tx = other.tx;
+                rx = other.rx;
+                rx_pending = other.rx_pending;
+                other.tx = ring();
+                other.rx = ring();
+                other.rx_pending = 0;
+        }
+        return *this;
+}
+
+int shm_channel::ring_create(ring& r, size_t capacity){
+        size_t page = page_size();
+        capacity = (capacity + page - 1) / page * page;
+        if (capacity == 0) {
+                capacity = page;
+        }
+
+        r.memfd = memfd_create("rsocket-shm", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+        r.data_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        r.space_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if ( r.memfd < 0 || r.data_fd < 0 || r.space_fd < 0
+             || ftruncate(r.memfd, (off_t) (page + capacity)) < 0
+             || fcntl(r.memfd, F_ADD_SEALS, SHM_SEALS) < 0 ) {
+                return -1;
+        }
+
+        // A new memfd reads as zeros, so head / tail / flags start out cleared
+        struct shm_ring_header* header = (struct shm_ring_header*) mmap(nullptr, page, PROT_READ | PROT_WRITE, MAP_SHARED, r.memfd, 0);
+        if (header == MAP_FAILED) {
+                return -1;
+        }
+        header->magic = SHM_MAGIC;
+        header->capacity = capacity;
+        munmap(header, page);
+        return ring_map(r);
+}
+
+// Header page, then the data pages twice: a frame running past the end continues in the second copy
+int shm_channel::ring_map(ring& r){
+        size_t page = page_size();
+        struct stat info;
+        if ( fstat(r.memfd, &info) < 0 ) {
+                return -1;
+        }
+        size_t size = (size_t) info.st_size;
+        int seals = fcntl(r.memfd, F_GET_SEALS);
+        if ( size <= page || (size - page) % page != 0 || seals < 0 || (seals & SHM_SEALS) != SHM_SEALS ) {
+                errno = EPROTO;
+                return -1;
+        }
+        size_t capacity = size - page;
+
+        char* base = (char*) mmap(nullptr, page + 2 * capacity, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (base == MAP_FAILED) {
+                return -1;
+        }
+        if ( mmap(base, page + capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, r.memfd, 0) == MAP_FAILED
+             || mmap(base + page + capacity, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, r.memfd, (off_t) page) == MAP_FAILED ) {
+                int errsv = errno;
+                munmap(base, page + 2 * capacity);
+                errno = errsv;
+                return -1;
+        }
+        r.header = (struct shm_ring_header*) base;
+        r.data = base + page;
+        r.capacity = capacity;
+        if (r.header->magic != SHM_MAGIC || r.header->capacity != capacity) {
+                errno = EPROTO;
+                return -1;
+        }
+        return 0;
+}
+
+void shm_channel::ring_close(ring& r){
+        if (r.header != nullptr) {
+                munmap(r.header, page_size() + 2 * r.capacity);
+        }
+        int fds[3] = {r.memfd, r.data_fd, r.space_fd};
+        for (int fd : fds) {
+                if (fd >= 0) {
+                        ::close(fd);
+                }
+        }
+        r = ring();
+}
+
+void shm_channel::notify(int fd){
+        uint64_t one = 1;
+        ssize_t ignored = ::write(fd, &one, sizeof(one));
+        (void) ignored;
+}
+
+void shm_channel::drain(int fd){
+        uint64_t count;
+        ssize_t ignored = read(fd, &count, sizeof(count));
+        (void) ignored;
+}
+
+int shm_channel::create(size_t capacity){
+        close();
+        if ( ring_create(tx, capacity) < 0 || ring_create(rx, capacity) < 0 ) {
+                int errsv = errno;
+                RSOCKET_LOG_ERROR("Failed to create shared memory rings (errno %d)", errsv);
+                close();
+                errno = errsv;
+                return -1;
+        }
+        return 0;
+}
+
+int shm_channel::offer(int unix_fd){
+        if ( !is_open() ) {
+                errno = ENOTCONN;
+                return -1;
+        }
+        struct shm_offer payload = {SHM_MAGIC, 0};
+        int fds[SHM_OFFER_FDS] = {tx.memfd, tx.data_fd, tx.space_fd, rx.memfd, rx.data_fd, rx.space_fd};
+        char control[CMSG_SPACE(sizeof(fds))] = {};
+        struct iovec iov = {&payload, sizeof(payload)};
+        struct msghdr msg = {};
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+        struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+        memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+        ssize_t sent;
+        while ( (sent = sendmsg(unix_fd, &msg, MSG_NOSIGNAL)) < 0 ) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                        struct pollfd pfd = {unix_fd, POLLOUT, 0};
+                        poll(&pfd, 1, -1);
+                } else if (errno != EINTR) {
+                        int errsv = errno;
+                        RSOCKET_LOG_ERROR("Failed to offer shared memory rings (errno %d)", errsv);
+                        errno = errsv;
+                        return -1;
+                }
+        }
+        return 0;
+}
+
+int shm_channel::accept(int unix_fd, int timeout){
+        close();
+        struct pollfd pfd = {unix_fd, POLLIN, 0};
+        int ready;
+        do {
+                ready = poll(&pfd, 1, timeout);
+        } while (ready < 0 && errno == EINTR);
+        if (ready <= 0) {
+                if (ready == 0) {
+                        errno = ETIMEDOUT;
+                }
+                return -1;
+        }
+
+        // Exactly the offer, anything the peer sends after it is left for the regular reads
+        struct shm_offer payload = {};
+        char control[CMSG_SPACE(SHM_OFFER_FDS * sizeof(int))] = {};
+        struct iovec iov = {&payload, sizeof(payload)};
+        struct msghdr msg = {};
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+        ssize_t received;
+        do {
+                received = recvmsg(unix_fd, &msg, MSG_CMSG_CLOEXEC | MSG_DONTWAIT);
+        } while (received < 0 && errno == EINTR);
+        if (received < 0) {
+                return -1;
+        }
+
+        int fds[SHM_OFFER_FDS];
+        int fd_count = 0;
+        for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+                if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+                        fd_count = (int) ((cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int));
+                        memcpy(fds, CMSG_DATA(cmsg), (size_t) std::min(fd_count, SHM_OFFER_FDS) * sizeof(int));
+                }
+        }
+        if ( received != (ssize_t) sizeof(payload) || payload.magic != SHM_MAGIC || fd_count != SHM_OFFER_FDS
+             || (msg.msg_flags & MSG_CTRUNC) ) {
+                for (int i = 0; i < std::min(fd_count, SHM_OFFER_FDS); i++) {
+                        ::close(fds[i]);
+                }
+                RSOCKET_LOG_ERROR("Peer did not offer shared memory rings");
+                errno = EPROTO;
+                return -1;
+        }
+
+        // The offerer's tx ring is our rx ring
+        rx.memfd = fds[0];
+        rx.data_fd = fds[1];
+        rx.space_fd = fds[2];
+        tx.memfd = fds[3];
+        tx.data_fd = fds[4];
+        tx.space_fd = fds[5];
+        if ( ring_map(rx) < 0 || ring_map(tx) < 0 ) {
+                int errsv = errno;
+                RSOCKET_LOG_ERROR("Failed to map shared memory rings (errno %d)", errsv);
+                close();
+                errno = errsv;
+                return -1;
+        }
+        return 0;
+}
+
+bool shm_channel::is_open(){
+        return tx.header != nullptr && rx.header != nullptr;
+}
+
+int shm_channel::try_write(const char* data, size_t length){
+        if ( !is_open() ) {
+                errno = ENOTCONN;
+                return -1;
+        }
+        size_t frame_size = FRAME_HEADER_SIZE + length;
+        if (length > UINT32_MAX || frame_size > tx.capacity) {
+                errno = EMSGSIZE;
+                return -1;
+        }
+        struct shm_ring_header* header = tx.header;
+        if ( header->reader_closed.load(std::memory_order_acquire) ) {
+                errno = EPIPE;
+                return -1;
+        }
+        uint64_t tail = header->tail.load(std::memory_order_relaxed);
+        uint64_t head = header->head.load(std::memory_order_acquire);
+        if (tx.capacity - (size_t) (tail - head) < frame_size) {
+                errno = EAGAIN;
+                return -1;
+        }
+
+        char* at = tx.data + (size_t) (tail % tx.capacity);
+        encode_frame_header((uint32_t) length, at);
+        memcpy(at + FRAME_HEADER_SIZE, data, length);
+        header->tail.store(tail + frame_size, std::memory_order_release);
+
+        // Pairs with the fence in prepare_wait(): either the reader sees the new tail or we see it waiting
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if ( header->reader_waiting.load(std::memory_order_relaxed) ) {
+                notify(tx.data_fd);
+        }
+        RSOCKET_COUNT(METRIC_BYTES_OUT, frame_size);
+        RSOCKET_COUNT(METRIC_MESSAGES_OUT, 1);
+        return 0;
+}
+
+int shm_channel::write(const char* data, size_t length, int timeout){
+        uint64_t deadline = metrics_now_us() + (uint64_t) (timeout < 0 ? 0 : timeout) * 1000;
+        while ( try_write(data, length) < 0 ) {
+                if (errno != EAGAIN) {
+                        return -1;
+                }
+                // Ring full, sleep until the reader frees some of it
+                struct shm_ring_header* header = tx.header;
+                header->writer_waiting.store(1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                uint64_t head = header->head.load(std::memory_order_acquire);
+                bool full = tx.capacity - (size_t) (header->tail.load(std::memory_order_relaxed) - head) < FRAME_HEADER_SIZE + length;
+                if ( full && !header->reader_closed.load(std::memory_order_acquire) ) {
+                        int wait = -1;
+                        if (timeout >= 0) {
+                                uint64_t now = metrics_now_us();
+                                if (now >= deadline) {
+                                        header->writer_waiting.store(0, std::memory_order_relaxed);
+                                        errno = ETIMEDOUT;
+                                        return -1;
+                                }
+                                wait = (int) ((deadline - now + 999) / 1000);
+                        }
+                        struct pollfd pfd = {tx.space_fd, POLLIN, 0};
+                        if ( poll(&pfd, 1, wait) < 0 && errno != EINTR ) {
+                                header->writer_waiting.store(0, std::memory_order_relaxed);
+                                return -1;
+                        }
+                        drain(tx.space_fd);
+                }
+                header->writer_waiting.store(0, std::memory_order_relaxed);
+        }
+        return 0;
+}
+
+size_t shm_channel::rx_available(){
+        uint64_t tail = rx.header->tail.load(std::memory_order_acquire);
+        return (size_t) (tail - rx.header->head.load(std::memory_order_relaxed));
+}
+
+void shm_channel::release_frame(){
+        if (rx_pending == 0) {
+                return;
+        }
+        struct shm_ring_header* header = rx.header;
+        header->head.store(header->head.load(std::memory_order_relaxed) + rx_pending, std::memory_order_release);
+        rx_pending = 0;
+        // Same handshake as try_write(), for a writer waiting for room
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if ( header->writer_waiting.load(std::memory_order_relaxed) ) {
+                notify(rx.space_fd);
+        }
+}
+
+bool shm_channel::next_frame(frame_view& frame){
+        if ( !is_open() ) {
+                return false;
+        }
+        release_frame();
+        struct shm_ring_header* header = rx.header;
+        if ( header->reader_waiting.load(std::memory_order_relaxed) ) {
+                // Woken up (or about to be), reset the wakeup
+                header->reader_waiting.store(0, std::memory_order_relaxed);
+                drain(rx.data_fd);
+        }
+
+        size_t available = rx_available();
+        if (available < FRAME_HEADER_SIZE) {
+                return false;
+        }
+        const char* at = rx.data + (size_t) (header->head.load(std::memory_order_relaxed) % rx.capacity);
+        size_t length = decode_frame_header(at);
+        if (FRAME_HEADER_SIZE + length > available) {
+                // Can't happen with a well behaved writer, which publishes whole frames
+                return false;
+        }
+        frame.data = at + FRAME_HEADER_SIZE;
+        frame.size = length;
+        rx_pending = FRAME_HEADER_SIZE + length;
+        RSOCKET_COUNT(METRIC_BYTES_IN, rx_pending);
+        RSOCKET_COUNT(METRIC_MESSAGES_IN, 1);
+        return true;
+}
+
+int shm_channel::event_fd(){
+        return rx.data_fd;
+}
+
+bool shm_channel::prepare_wait(){
+        if ( !is_open() ) {
+                return false;
+        }
+        release_frame();
+        rx.header->reader_waiting.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return rx_available() == 0 && !rx.header->writer_closed.load(std::memory_order_acquire);
+}
+
+int shm_channel::wait_readable(int timeout){
+        if ( !prepare_wait() ) {
+                return is_open() ? 1 : -1;
+        }
+        struct pollfd pfd = {rx.data_fd, POLLIN, 0};
+        int ready = poll(&pfd, 1, timeout);
+        if (ready < 0) {
+                return (errno == EINTR) ? 0 : -1;
+        }
+        return ready > 0 ? 1 : 0;
+}
+
+bool shm_channel::peer_closed(){
+        if ( !is_open() ) {
+                return true;
+        }
+        return rx.header->writer_closed.load(std::memory_order_acquire) && rx_pending == 0 && rx_available() == 0;
+}
+
+void shm_channel::close(){
+        if ( is_open() ) {
+                // Wake both sides of the peer so it notices right away
+                tx.header->writer_closed.store(1, std::memory_order_release);
+                notify(tx.data_fd);
+                rx.header->reader_closed.store(1, std::memory_order_release);
+                notify(rx.space_fd);
+        }
+        ring_close(tx);
+        ring_close(rx);
+        rx_pending = 0;
+}
@@ -0,0 +1,155 @@
+//--------------------------
+// Shared memory channel module header
+//--------------------------
+// Description:
+// Same-host message transport over two single producer / single consumer rings in shared memory
+// (memfd + mmap), with eventfd wakeups. Set up over a connected AF_UNIX socket (SCM_RIGHTS)
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#ifndef _shm_channel_H_INCLUDED
+#define _shm_channel_H_INCLUDED
+
+// Default settings
+//-----------------------------
+// Default ring size (bytes, per direction), rounded up to the page size
+#define DEFAULT_SHM_RING_SIZE (1024 * 1024)
+// Time (ms) accept() waits for the peer's offer
+#define DEFAULT_SHM_ACCEPT_TIMEOUT 5000
+// Tags the offer message and the ring headers
+#define SHM_MAGIC 0x4d485352
+//-----------------------------
+
+// Includes
+//-----------------------------
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+
+#include "framing.h"
+#include "logger.h"
+#include "metrics.h"
+//-----------------------------
+
+// First page of every ring. Producer and consumer fields sit on separate cache lines
+struct shm_ring_header
+{
+        uint32_t magic;
+        uint64_t capacity;
+
+        // Consumer side: bytes consumed, consumer sleeping on the data eventfd
+        alignas(64) std::atomic<uint64_t> head;
+        std::atomic<uint32_t> reader_waiting;
+        std::atomic<uint32_t> reader_closed;
+
+        // Producer side: bytes produced, producer sleeping on the space eventfd
+        alignas(64) std::atomic<uint64_t> tail;
+        std::atomic<uint32_t> writer_waiting;
+        std::atomic<uint32_t> writer_closed;
+};
+
+// Bidirectional message channel between two processes on one host, bypassing the network stack
+// Each direction is a ring of FRAMING_LENGTH_PREFIXED frames (the same bytes a length-prefixed socket carries).
+// The ring's pages are mapped twice back to back, so a frame wrapping around the end is still contiguous
+// and next_frame() hands out views straight into shared memory
+// Eventfds are only written while the other side sleeps, a busy channel makes no syscalls at all
+//
+// Setup: one side create()s the rings and offer()s them over a connected AF_UNIX socket, the other accept()s
+// (see client_socket::c_open_shm() / server_socket::s_accept_shm()). Keep the socket open, its hangup is how
+// a crashed peer shows up
+// Not thread-safe: one thread writes and one thread reads on each side
+class shm_channel
+{
+    private:
+        struct ring
+        {
+                shm_ring_header* header = nullptr;
+                // Data pages, mapped twice (2 * capacity bytes of address space)
+                char* data = nullptr;
+                size_t capacity = 0;
+                // memfd, producer -> consumer eventfd, consumer -> producer eventfd
+                int memfd = -1;
+                int data_fd = -1;
+                int space_fd = -1;
+        };
+
+        // We write tx and read rx
+        ring tx;
+        ring rx;
+        // Size of the frame last returned by next_frame(), released on the next call
+        size_t rx_pending = 0;
+
+        static int ring_create(ring& r, size_t capacity);
+        static int ring_map(ring& r);
+        static void ring_close(ring& r);
+        static void notify(int fd);
+        static void drain(int fd);
+        // Bytes readable in rx
+        size_t rx_available();
+        void release_frame();
+
+    public:
+        shm_channel() = default;
+        ~shm_channel();
+
+        shm_channel(const shm_channel&) = delete;
+        shm_channel& operator=(const shm_channel&) = delete;
+        shm_channel(shm_channel&& other) noexcept;
+        shm_channel& operator=(shm_channel&& other) noexcept;
+
+        // Allocate both rings (capacity bytes each, rounded up to the page size), 0 or -1
+        int create(size_t capacity = DEFAULT_SHM_RING_SIZE);
+
+        // Send the rings to the peer of the connected AF_UNIX socket unix_fd, 0 or -1
+        int offer(int unix_fd);
+
+        // Map the rings offered by the peer of unix_fd, waiting up to timeout ms (-1 = forever) for them
+        // Must happen before anything else is read from unix_fd. 0 or -1 (ETIMEDOUT, EPROTO for anything but an offer)
+        int accept(int unix_fd, int timeout = DEFAULT_SHM_ACCEPT_TIMEOUT);
+
+        bool is_open();
+
+        // Queue one message without blocking
+        // Returns 0, or -1 with errno EAGAIN (ring full), EMSGSIZE (larger than the ring) or EPIPE (peer closed)
+        int try_write(const char* data, size_t length);
+
+        // Queue one message, waiting up to timeout ms (-1 = forever) for room. 0 or -1 (errno ETIMEDOUT, ...)
+        int write(const char* data, size_t length, int timeout = -1);
+
+        // Next message from the peer, the view points into shared memory and stays valid until the next call
+        // Returns false once nothing is pending (check peer_closed() for the end of the stream)
+        bool next_frame(frame_view& frame);
+
+        // Wait up to timeout ms (-1 = forever) for a message. 1 readable (or the peer closed), 0 timeout, -1 error
+        int wait_readable(int timeout);
+
+        // For external event loops: becomes readable when a message arrives, but only after prepare_wait()
+        // returned true. prepare_wait() returns false (don't sleep) if a message is already pending
+        int event_fd();
+        bool prepare_wait();
+
+        // Peer called close() and everything it wrote has been read
+        bool peer_closed();
+
+        // Tell the peer we're done (it reads what is left, then sees peer_closed()) and unmap everything
+        void close();
+};
+
+#endif // shm_channel.h
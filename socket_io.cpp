@@ -0,0 +1,238 @@
+//--------------------------
+// Socket I/O module
+//--------------------------
+// Description:
+// Vectored, file (sendfile / splice) and MSG_ZEROCOPY send helpers shared by client_socket and server_socket,
+// plus AF_UNIX addressing
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#include "socket_io.h"
+
+int advance_iov(struct iovec* iov, int iovcnt, size_t num_bytes){
+        int i = 0;
+        while (i < iovcnt && num_bytes >= iov[i].iov_len) {
+                num_bytes -= iov[i].iov_len;
+                i++;
+        }
+        if (i < iovcnt) {
+                iov[i].iov_base = (char*) iov[i].iov_base + num_bytes;
+                iov[i].iov_len -= num_bytes;
+        }
+        return i;
+}
+
+long send_iov_once(int fd, struct iovec* iov, int iovcnt, int flags){
+        struct msghdr msg = {};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = (size_t) (iovcnt < SEND_IOV_MAX ? iovcnt : SEND_IOV_MAX);
+
+        long num_bytes;
+        do {
+                num_bytes = (long) sendmsg(fd, &msg, flags | MSG_NOSIGNAL | MSG_DONTWAIT);
+        } while (num_bytes < 0 && errno == EINTR);
+
+        if (num_bytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                RSOCKET_COUNT(METRIC_WRITE_EAGAIN, 1);
+                return 0;
+        }
+        if (num_bytes > 0) {
+                RSOCKET_COUNT(METRIC_BYTES_OUT, num_bytes);
+        }
+        return num_bytes;
+}
+
+long send_iov_all(int fd, struct iovec* iov, int iovcnt, int flags){
+        long total = 0;
+        int first = 0;
+        // Skip empty iovecs so a fully sent batch is detected
+        while (first < iovcnt && iov[first].iov_len == 0) {
+                first++;
+        }
+
+        while (first < iovcnt) {
+                int count = iovcnt - first;
+                // Only the final chunk may go out without MSG_MORE
+                int chunk_flags = flags | (count > SEND_IOV_MAX ? MSG_MORE : 0);
+                long num_bytes = send_iov_once(fd, iov + first, count, chunk_flags);
+                if (num_bytes < 0) {
+                        return -1;
+                }
+                if (num_bytes == 0) {
+                        // Socket buffer full, wait until the peer catches up
+                        struct pollfd pfd = {fd, POLLOUT, 0};
+                        if ( poll(&pfd, 1, -1) < 0 && errno != EINTR ) {
+                                return -1;
+                        }
+                        continue;
+                }
+                total += num_bytes;
+                first += advance_iov(iov + first, count, (size_t) num_bytes);
+                while (first < iovcnt && iov[first].iov_len == 0) {
+                        first++;
+                }
+        }
+        return total;
+}
+
+long send_file_once(int fd, int file_fd, off_t* offset, size_t count){
+        if (count == 0) {
+                return 0;
+        }
+        long num_bytes;
+        do {
+                num_bytes = (long) sendfile(fd, file_fd, offset, count);
+        } while (num_bytes < 0 && errno == EINTR);
+
+        if (num_bytes < 0 && (errno == EINVAL || errno == ESPIPE)) {
+                // sendfile() only reads from mmap-able files, a pipe has to be spliced
+                int errsv = errno;
+                struct stat info;
+                if ( fstat(file_fd, &info) == 0 && S_ISFIFO(info.st_mode) ) {
+                        do {
+                                num_bytes = (long) splice(file_fd, nullptr, fd, nullptr, count, SPLICE_F_MOVE | SPLICE_F_NONBLOCK | SPLICE_F_MORE);
+                        } while (num_bytes < 0 && errno == EINTR);
+                } else {
+                        errno = errsv;
+                }
+        }
+
+        if (num_bytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                RSOCKET_COUNT(METRIC_WRITE_EAGAIN, 1);
+                return 0;
+        }
+        if (num_bytes == 0) {
+                // End of file before count bytes, the peer was promised more than there is
+                errno = ENODATA;
+                return -1;
+        }
+        RSOCKET_COUNT(METRIC_BYTES_OUT, num_bytes);
+        return num_bytes;
+}
+
+long send_file_all(int fd, int file_fd, off_t offset, size_t count){
+        long total = 0;
+        while (count > 0) {
+                long num_bytes = send_file_once(fd, file_fd, &offset, count);
+                if (num_bytes < 0) {
+                        return -1;
+                }
+                if (num_bytes == 0) {
+                        // Socket buffer full (or an empty pipe), wait for either side
+                        struct pollfd pfd[2] = {{fd, POLLOUT, 0}, {file_fd, POLLIN, 0}};
+                        if ( poll(pfd, 2, -1) < 0 && errno != EINTR ) {
+                                return -1;
+                        }
+                        continue;
+                }
+                total += num_bytes;
+                count -= (size_t) num_bytes;
+        }
+        return total;
+}
+
+int enable_zerocopy(int fd){
+        int one = 1;
+        return setsockopt(fd, SOL_SOCKET, SO_ZEROCOPY, &one, sizeof(one));
+}
+
+long send_zerocopy_all(int fd, struct iovec* iov, int iovcnt, int flags, uint64_t* sends){
+        long total = 0;
+        int first = 0;
+        while (first < iovcnt && iov[first].iov_len == 0) {
+                first++;
+        }
+
+        while (first < iovcnt) {
+                int count = iovcnt - first;
+                int chunk_flags = flags | (count > SEND_IOV_MAX ? MSG_MORE : 0);
+                long num_bytes = send_iov_once(fd, iov + first, count, chunk_flags | MSG_ZEROCOPY);
+                if (num_bytes < 0 && errno == ENOBUFS) {
+                        // Out of optmem for pinned pages, copy this chunk instead
+                        num_bytes = send_iov_once(fd, iov + first, count, chunk_flags);
+                } else if (num_bytes > 0) {
+                        (*sends)++;
+                }
+                if (num_bytes < 0) {
+                        return -1;
+                }
+                if (num_bytes == 0) {
+                        struct pollfd pfd = {fd, POLLOUT, 0};
+                        if ( poll(&pfd, 1, -1) < 0 && errno != EINTR ) {
+                                return -1;
+                        }
+                        continue;
+                }
+                total += num_bytes;
+                first += advance_iov(iov + first, count, (size_t) num_bytes);
+                while (first < iovcnt && iov[first].iov_len == 0) {
+                        first++;
+                }
+        }
+        return total;
+}
+
+long reap_zerocopy(int fd, uint64_t* copied){
+        long completed = 0;
+        while (true) {
+                char control[CMSG_SPACE(sizeof(struct sock_extended_err) + sizeof(struct sockaddr_in6))];
+                struct msghdr msg = {};
+                msg.msg_control = control;
+                msg.msg_controllen = sizeof(control);
+
+                if ( recvmsg(fd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0 ) {
+                        if (errno == EINTR) {
+                                continue;
+                        }
+                        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                                return completed;
+                        }
+                        return -1;
+                }
+
+                for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+                        bool recverr = (cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR)
+                                    || (cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR);
+                        if (!recverr) {
+                                continue;
+                        }
+                        const struct sock_extended_err* error = (const struct sock_extended_err*) CMSG_DATA(cmsg);
+                        if (error->ee_origin != SO_EE_ORIGIN_ZEROCOPY || error->ee_errno != 0) {
+                                continue;
+                        }
+                        // Notifications cover the inclusive id range [ee_info, ee_data]
+                        long range = (long) (uint32_t) (error->ee_data - error->ee_info) + 1;
+                        completed += range;
+                        if (error->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) {
+                                *copied += (uint64_t) range;
+                        }
+                }
+        }
+}
+
+int unix_address(const char* path, struct sockaddr_un& address, socklen_t& length){
+        size_t path_length = (path != nullptr) ? strlen(path) : 0;
+        if (path_length == 0) {
+                errno = EINVAL;
+                return -1;
+        }
+        // Filesystem paths need room for the terminating NUL, abstract names don't
+        if ( path_length >= sizeof(address.sun_path) + (path[0] == '@' ? 1 : 0) ) {
+                errno = ENAMETOOLONG;
+                return -1;
+        }
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        memcpy(address.sun_path, path, path_length);
+        if (path[0] == '@') {
+                address.sun_path[0] = '\0';
+        }
+        length = (socklen_t) (offsetof(struct sockaddr_un, sun_path) + path_length + (path[0] == '@' ? 0 : 1));
+        return 0;
+}
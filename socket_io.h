@@ -0,0 +1,99 @@
+//--------------------------
+// Socket I/O module header
+//--------------------------
+// Description:
+// Vectored, file (sendfile / splice) and MSG_ZEROCOPY send helpers shared by client_socket and server_socket,
+// plus AF_UNIX addressing
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#ifndef _socket_io_H_INCLUDED
+#define _socket_io_H_INCLUDED
+
+// Includes
+//-----------------------------
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstring>
+#include <cstdint>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/sendfile.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <linux/errqueue.h>
+#include <netinet/in.h>
+
+#include "metrics.h"
+//-----------------------------
+
+// Max iovecs passed to one sendmsg()
+#ifdef IOV_MAX
+#define SEND_IOV_MAX IOV_MAX
+#else
+#define SEND_IOV_MAX 1024
+#endif
+
+// Payloads smaller than this are copied even with zero copy enabled, pinning pages costs more than the copy
+#define ZEROCOPY_MIN_SIZE (16 * 1024)
+
+// Older headers
+#ifndef SO_ZEROCOPY
+#define SO_ZEROCOPY 60
+#endif
+#ifndef MSG_ZEROCOPY
+#define MSG_ZEROCOPY 0x4000000
+#endif
+
+// Skip the first num_bytes of iov[0..iovcnt), adjusting the partially sent iovec in place
+// Returns the index of the first iovec with data left
+int advance_iov(struct iovec* iov, int iovcnt, size_t num_bytes);
+
+// Send everything described by iov with as few sendmsg() calls as possible
+// Short writes and EINTR are retried, EAGAIN waits for writability, SIGPIPE is suppressed
+// flags are passed to sendmsg() (e.g., MSG_MORE), iov is modified
+// Returns total bytes sent or -1
+long send_iov_all(int fd, struct iovec* iov, int iovcnt, int flags);
+
+// Single non-blocking attempt, returns bytes sent (may be short), 0 on EAGAIN, -1 on error
+long send_iov_once(int fd, struct iovec* iov, int iovcnt, int flags);
+
+// Send count bytes of file_fd from *offset straight from the page cache (sendfile()), advancing *offset
+// A pipe is spliced instead (offset ignored), so output of another process can be streamed too
+// Single non-blocking attempt, returns bytes sent, 0 on EAGAIN, -1 on error (ENODATA if the file ends early)
+long send_file_once(int fd, int file_fd, off_t* offset, size_t count);
+
+// Same, retried until everything is sent like send_iov_all()
+// Returns total bytes sent or -1
+long send_file_all(int fd, int file_fd, off_t offset, size_t count);
+
+// Allow MSG_ZEROCOPY sends on fd (SO_ZEROCOPY), fails with EOPNOTSUPP on sockets without support
+int enable_zerocopy(int fd);
+
+// send_iov_all() with MSG_ZEROCOPY: the pages are handed to the NIC instead of copied, so the data
+// must not change until reap_zerocopy() has counted *sends more completions (no stack buffers)
+// *sends is incremented once per sendmsg() issued with MSG_ZEROCOPY (the kernel's notification ids)
+// Returns total bytes sent or -1
+long send_zerocopy_all(int fd, struct iovec* iov, int iovcnt, int flags, uint64_t* sends);
+
+// Drain zero copy completion notifications from the socket error queue without blocking
+// *copied is incremented for sends the kernel had to copy after all (e.g., loopback)
+// Returns the number of MSG_ZEROCOPY sends completed (0 if none yet) or -1
+long reap_zerocopy(int fd, uint64_t* copied);
+
+// Fill address for an AF_UNIX socket path, a leading '@' names a socket in the abstract namespace
+// (Linux only, no file is created and nothing needs to be unlinked)
+// Returns 0, or -1 with errno EINVAL (empty path) / ENAMETOOLONG
+int unix_address(const char* path, struct sockaddr_un& address, socklen_t& length);
+
+#endif // socket_io.h
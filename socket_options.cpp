@@ -0,0 +1,123 @@
+//--------------------------
+// Socket options module
+//--------------------------
+// Description:
+// Declarative socket tuning (Nagle, buffer sizes, TCP Fast Open, quick ACKs, busy polling, CPU affinity)
+// applied by server_socket and client_socket at create, accept and connect time
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#include "socket_options.h"
+
+// Largest buffer TCP autotuning grows to (third field of net.ipv4.tcp_rmem / tcp_wmem), -1 if unknown
+static long autotune_limit(const char* path){
+        FILE* file = fopen(path, "r");
+        if (file == nullptr) {
+                return -1;
+        }
+        long low, initial, high;
+        int fields = fscanf(file, "%ld %ld %ld", &low, &initial, &high);
+        fclose(file);
+        return (fields == 3) ? high : -1;
+}
+
+// Set one option unless it is unset, remembering the first failure in *error
+static void set_option(int fd, int level, int name, int value, const char* label, int* error){
+        if (value == SOCKET_OPTION_UNSET) {
+                return;
+        }
+        if ( setsockopt(fd, level, name, &value, sizeof(value)) < 0 ) {
+                int errsv = errno;
+                RSOCKET_LOG_WARN("%s %d failed on fd %d (errno %d)", label, value, fd, errsv);
+                if (*error == 0) {
+                        *error = errsv;
+                }
+        }
+}
+
+static int option_result(int error){
+        if (error != 0) {
+                errno = error;
+                return -1;
+        }
+        return 0;
+}
+
+socket_options socket_options::low_latency(){
+        socket_options options;
+        options.nodelay = 1;
+        options.quickack = 1;
+        options.fastopen = DEFAULT_FASTOPEN_QUEUE;
+        options.busy_poll_usecs = LOW_LATENCY_BUSY_POLL_USECS;
+        return options;
+}
+
+socket_options socket_options::high_throughput(){
+        socket_options options;
+        options.nodelay = 0;
+        // A fixed size turns autotuning off, only worth it where autotuning stops short of it
+        if ( autotune_limit("/proc/sys/net/ipv4/tcp_rmem") < HIGH_THROUGHPUT_BUFFER_SIZE ) {
+                options.recv_buffer = HIGH_THROUGHPUT_BUFFER_SIZE;
+        }
+        if ( autotune_limit("/proc/sys/net/ipv4/tcp_wmem") < HIGH_THROUGHPUT_BUFFER_SIZE ) {
+                options.send_buffer = HIGH_THROUGHPUT_BUFFER_SIZE;
+        }
+        return options;
+}
+
+int apply_listen_options(int fd, const socket_options& options, bool tcp){
+        int error = 0;
+        set_option(fd, SOL_SOCKET, SO_RCVBUF, options.recv_buffer, "SO_RCVBUF", &error);
+        set_option(fd, SOL_SOCKET, SO_SNDBUF, options.send_buffer, "SO_SNDBUF", &error);
+        set_option(fd, SOL_SOCKET, SO_BUSY_POLL, options.busy_poll_usecs, "SO_BUSY_POLL", &error);
+        set_option(fd, SOL_SOCKET, SO_INCOMING_CPU, options.incoming_cpu, "SO_INCOMING_CPU", &error);
+        if (tcp) {
+                set_option(fd, IPPROTO_TCP, TCP_FASTOPEN, options.fastopen, "TCP_FASTOPEN", &error);
+        }
+        return option_result(error);
+}
+
+int apply_accept_options(int fd, const socket_options& options, bool tcp){
+        int error = 0;
+        if (tcp) {
+                set_option(fd, IPPROTO_TCP, TCP_NODELAY, options.nodelay, "TCP_NODELAY", &error);
+                set_option(fd, IPPROTO_TCP, TCP_QUICKACK, options.quickack, "TCP_QUICKACK", &error);
+        }
+        return option_result(error);
+}
+
+int apply_connect_options(int fd, const socket_options& options, bool tcp){
+        int error = 0;
+        set_option(fd, SOL_SOCKET, SO_RCVBUF, options.recv_buffer, "SO_RCVBUF", &error);
+        set_option(fd, SOL_SOCKET, SO_SNDBUF, options.send_buffer, "SO_SNDBUF", &error);
+        set_option(fd, SOL_SOCKET, SO_BUSY_POLL, options.busy_poll_usecs, "SO_BUSY_POLL", &error);
+        set_option(fd, SOL_SOCKET, SO_INCOMING_CPU, options.incoming_cpu, "SO_INCOMING_CPU", &error);
+        if (tcp) {
+                set_option(fd, IPPROTO_TCP, TCP_NODELAY, options.nodelay, "TCP_NODELAY", &error);
+                set_option(fd, IPPROTO_TCP, TCP_QUICKACK, options.quickack, "TCP_QUICKACK", &error);
+                // Only on / off for clients, the listener's value is a queue length
+                if (options.fastopen != SOCKET_OPTION_UNSET) {
+                        set_option(fd, IPPROTO_TCP, TCP_FASTOPEN_CONNECT, options.fastopen > 0 ? 1 : 0, "TCP_FASTOPEN_CONNECT", &error);
+                }
+        }
+        return option_result(error);
+}
+
+int pin_thread(int cpu){
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(cpu, &cpu_set);
+        int err = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+        if (err != 0) {
+                RSOCKET_LOG_WARN("Failed to pin thread to CPU %d (errno %d)", cpu, err);
+                errno = err;
+                return -1;
+        }
+        return 0;
+}
@@ -0,0 +1,99 @@
+//--------------------------
+// Socket options module header
+//--------------------------
+// Description:
+// Declarative socket tuning (Nagle, buffer sizes, TCP Fast Open, quick ACKs, busy polling, CPU affinity)
+// applied by server_socket and client_socket at create, accept and connect time
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#ifndef _socket_options_H_INCLUDED
+#define _socket_options_H_INCLUDED
+
+// Default settings
+//-----------------------------
+// Option value meaning "leave the kernel default alone"
+#define SOCKET_OPTION_UNSET -1
+// Low latency profile: SO_BUSY_POLL (µs) and TCP Fast Open queue length of a listener
+#define LOW_LATENCY_BUSY_POLL_USECS 50
+#define DEFAULT_FASTOPEN_QUEUE 256
+// High throughput profile: SO_RCVBUF / SO_SNDBUF (bytes, the kernel doubles them and caps them to
+// net.core.rmem_max / wmem_max)
+#define HIGH_THROUGHPUT_BUFFER_SIZE (4 * 1024 * 1024)
+//-----------------------------
+
+// Includes
+//-----------------------------
+#include <cerrno>
+#include <cstdio>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+#include "logger.h"
+//-----------------------------
+
+// Older headers
+#ifndef TCP_FASTOPEN_CONNECT
+#define TCP_FASTOPEN_CONNECT 30
+#endif
+#ifndef SO_INCOMING_CPU
+#define SO_INCOMING_CPU 49
+#endif
+
+// What to set on a socket, every field defaults to SOCKET_OPTION_UNSET (kernel default)
+// Options that don't apply to the socket (TCP options on AF_UNIX / UDP) are skipped
+// Failures are logged and otherwise ignored, a socket that can't be tuned still works
+struct socket_options
+{
+        // TCP_NODELAY (0 / 1): send small messages right away instead of batching them (Nagle)
+        int nodelay = SOCKET_OPTION_UNSET;
+        // TCP_QUICKACK (0 / 1): ACK immediately instead of delaying. The kernel drops back to delayed ACKs
+        // on its own, so this is a hint for the start of each connection
+        int quickack = SOCKET_OPTION_UNSET;
+        // SO_RCVBUF / SO_SNDBUF (bytes). Setting them turns off the kernel's buffer autotuning
+        // Accepted sockets inherit the listener's, set before listen() / connect() so TCP scales its window
+        int recv_buffer = SOCKET_OPTION_UNSET;
+        int send_buffer = SOCKET_OPTION_UNSET;
+        // TCP Fast Open, data rides on the SYN of repeat connections (saves a round trip)
+        // Listener: queue length (needs net.ipv4.tcp_fastopen & 2). Client: 1 turns on TCP_FASTOPEN_CONNECT,
+        // connect() then returns at once and connection errors show up on the first write
+        int fastopen = SOCKET_OPTION_UNSET;
+        // SO_BUSY_POLL (µs): let reads poll the NIC queue instead of waiting for its interrupt
+        // Values above net.core.busy_read need CAP_NET_ADMIN
+        int busy_poll_usecs = SOCKET_OPTION_UNSET;
+        // SO_INCOMING_CPU: on SO_REUSEPORT listeners, prefer handing this listener connections whose packets
+        // arrive on this CPU, so the thread serving them shares a cache with the interrupt (see server_group)
+        int incoming_cpu = SOCKET_OPTION_UNSET;
+        // Pin the thread that calls server_socket::s_init() / client_socket::c_create() to this CPU
+        int cpu = SOCKET_OPTION_UNSET;
+
+        // Request / response traffic: no Nagle, immediate ACKs, busy polling, Fast Open
+        static socket_options low_latency();
+        // Bulk transfers: Nagle left on to fill segments, and HIGH_THROUGHPUT_BUFFER_SIZE socket buffers
+        // where TCP autotuning (net.ipv4.tcp_rmem / tcp_wmem) would stop below that
+        static socket_options high_throughput();
+};
+
+// Set on a socket that is about to bind() / listen() (accepted sockets inherit buffers and busy polling)
+// tcp: socket is a TCP socket. Returns 0, or -1 with errno of the first option that failed
+int apply_listen_options(int fd, const socket_options& options, bool tcp);
+
+// Set on a socket returned by accept() (only what it doesn't inherit from the listener)
+int apply_accept_options(int fd, const socket_options& options, bool tcp);
+
+// Set on a client socket before connect()
+int apply_connect_options(int fd, const socket_options& options, bool tcp);
+
+// Pin the calling thread to cpu, 0 or -1
+int pin_thread(int cpu);
+
+#endif // socket_options.h
@@ -0,0 +1,141 @@
+//--------------------------
+// Task module header
+//--------------------------
+// Description:
+// Lazily started, awaitable C++20 coroutine type used by the async API (see async_server.h)
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#ifndef _task_H_INCLUDED
+#define _task_H_INCLUDED
+
+// Includes
+//-----------------------------
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+//-----------------------------
+
+template<typename T = void>
+class task;
+
+// Promise parts shared by task<T> and task<void>
+// The body starts when the task is awaited, and the awaiting coroutine is resumed (symmetric transfer,
+// so long await chains don't grow the stack) when the body finishes
+struct task_promise_base
+{
+        std::coroutine_handle<> continuation;
+        std::exception_ptr exception;
+
+        struct final_awaiter
+        {
+                bool await_ready() noexcept { return false; }
+
+                template<typename Promise>
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> finished) noexcept {
+                        std::coroutine_handle<> next = finished.promise().continuation;
+                        return next ? next : std::noop_coroutine();
+                }
+
+                void await_resume() noexcept {}
+        };
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        final_awaiter final_suspend() noexcept { return {}; }
+        void unhandled_exception() noexcept { exception = std::current_exception(); }
+};
+
+template<typename T>
+struct task_promise : task_promise_base
+{
+        std::optional<T> value;
+
+        task<T> get_return_object() noexcept;
+
+        template<typename U>
+        void return_value(U&& result) { value.emplace(std::forward<U>(result)); }
+
+        T result() {
+                if (exception) {
+                        std::rethrow_exception(exception);
+                }
+                return std::move(*value);
+        }
+};
+
+template<>
+struct task_promise<void> : task_promise_base
+{
+        task<void> get_return_object() noexcept;
+
+        void return_void() noexcept {}
+
+        void result() {
+                if (exception) {
+                        std::rethrow_exception(exception);
+                }
+        }
+};
+
+// Owns its coroutine frame, move-only
+template<typename T>
+class task
+{
+    public:
+        typedef task_promise<T> promise_type;
+
+    private:
+        std::coroutine_handle<promise_type> coroutine;
+
+    public:
+        task() noexcept {}
+        explicit task(std::coroutine_handle<promise_type> c) noexcept : coroutine(c) {}
+        ~task() {
+                if (coroutine) {
+                        coroutine.destroy();
+                }
+        }
+
+        task(task&& other) noexcept : coroutine(std::exchange(other.coroutine, nullptr)) {}
+        task& operator=(task&& other) noexcept {
+                if (this != &other) {
+                        if (coroutine) {
+                                coroutine.destroy();
+                        }
+                        coroutine = std::exchange(other.coroutine, nullptr);
+                }
+                return *this;
+        }
+        task(const task&) = delete;
+        task& operator=(const task&) = delete;
+
+        bool valid() const noexcept { return (bool) coroutine; }
+
+        // co_await runs the task and yields its co_return value (or rethrows what it threw)
+        bool await_ready() const noexcept { return !coroutine || coroutine.done(); }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                coroutine.promise().continuation = awaiting;
+                return coroutine;
+        }
+
+        T await_resume() { return coroutine.promise().result(); }
+};
+
+template<typename T>
+inline task<T> task_promise<T>::get_return_object() noexcept {
+        return task<T>(std::coroutine_handle<task_promise<T>>::from_promise(*this));
+}
+
+inline task<void> task_promise<void>::get_return_object() noexcept {
+        return task<void>(std::coroutine_handle<task_promise<void>>::from_promise(*this));
+}
+
+#endif // task.h
@@ -0,0 +1,207 @@
+//--------------------------
+// Timer wheel module
+//--------------------------
+// Description:
+// Hierarchical timer wheel with O(1) arm / cancel, for per-connection timeouts on the event loop
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#include "timer_wheel.h"
+
+// End of a list / node not on any list
+#define NO_SLOT UINT32_MAX
+#define TIMER_WHEEL_MASK (TIMER_WHEEL_SLOTS - 1)
+// Longest delay the top level can hold
+#define TIMER_WHEEL_RANGE ((uint64_t) 1 << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS))
+
+// Distance (1..64) from position to the next set bit of bits after it, going round, 0 if bits is empty
+static unsigned next_occupied(uint64_t bits, unsigned position){
+        if (bits == 0) {
+                return 0;
+        }
+        unsigned shift = (position + 1) & TIMER_WHEEL_MASK;
+        uint64_t rotated = (shift == 0) ? bits : (bits >> shift) | (bits << (64 - shift));
+        return (unsigned) __builtin_ctzll(rotated) + 1;
+}
+
+//-----------------------------
+// Class: timer_wheel
+//-----------------------------
+
+timer_wheel::timer_wheel(uint64_t now_ms){
+        current = now_ms;
+        free_head = NO_SLOT;
+        for (uint32_t& head : heads) {
+                head = NO_SLOT;
+        }
+        for (uint64_t& bits : occupied) {
+                bits = 0;
+        }
+}
+
+// Lowest level whose slots still tell this expiry apart from the current time
+void timer_wheel::link(uint32_t index){
+        timer_node& node = nodes[index];
+        uint64_t delta = node.expires - current;
+        int level = 0;
+        while ( level < TIMER_WHEEL_LEVELS - 1 && delta >= ((uint64_t) 1 << (TIMER_WHEEL_BITS * (level + 1))) ) {
+                level++;
+        }
+        uint32_t slot = (uint32_t) (level * TIMER_WHEEL_SLOTS) + (uint32_t) ((node.expires >> (TIMER_WHEEL_BITS * level)) & TIMER_WHEEL_MASK);
+
+        node.slot = slot;
+        node.prev = NO_SLOT;
+        node.next = heads[slot];
+        if (node.next != NO_SLOT) {
+                nodes[node.next].prev = index;
+        }
+        heads[slot] = index;
+        occupied[level] |= (uint64_t) 1 << (slot & TIMER_WHEEL_MASK);
+}
+
+void timer_wheel::unlink(uint32_t index){
+        timer_node& node = nodes[index];
+        if (node.prev != NO_SLOT) {
+                nodes[node.prev].next = node.next;
+        } else {
+                heads[node.slot] = node.next;
+        }
+        if (node.next != NO_SLOT) {
+                nodes[node.next].prev = node.prev;
+        }
+        if (heads[node.slot] == NO_SLOT) {
+                occupied[node.slot / TIMER_WHEEL_SLOTS] &= ~((uint64_t) 1 << (node.slot & TIMER_WHEEL_MASK));
+        }
+        node.slot = NO_SLOT;
+}
+
+// New generation so handles to the old timer stop matching
+void timer_wheel::release(uint32_t index){
+        timer_node& node = nodes[index];
+        node.generation++;
+        node.next = free_head;
+        free_head = index;
+        armed--;
+}
+
+timer_handle timer_wheel::schedule(uint64_t delay_ms, uint64_t cookie){
+        uint32_t index;
+        if (free_head != NO_SLOT) {
+                index = free_head;
+                free_head = nodes[index].next;
+        } else {
+                index = (uint32_t) nodes.size();
+                nodes.push_back(timer_node{0, 0, NO_SLOT, NO_SLOT, 1, NO_SLOT});
+        }
+        if (delay_ms == 0) {
+                delay_ms = 1;
+        }
+        if (delay_ms >= TIMER_WHEEL_RANGE) {
+                delay_ms = TIMER_WHEEL_RANGE - 1;
+        }
+        timer_node& node = nodes[index];
+        node.expires = current + delay_ms;
+        node.cookie = cookie;
+        link(index);
+        armed++;
+        return timer_handle{index, node.generation};
+}
+
+bool timer_wheel::active(timer_handle handle){
+        return handle.index < nodes.size() && nodes[handle.index].generation == handle.generation
+               && nodes[handle.index].slot != NO_SLOT;
+}
+
+bool timer_wheel::cancel(timer_handle& handle){
+        bool armed_timer = active(handle);
+        if (armed_timer) {
+                unlink(handle.index);
+                release(handle.index);
+        }
+        handle = timer_handle();
+        return armed_timer;
+}
+
+void timer_wheel::cascade(int level, uint32_t slot){
+        uint32_t index = heads[level * TIMER_WHEEL_SLOTS + slot];
+        heads[level * TIMER_WHEEL_SLOTS + slot] = NO_SLOT;
+        occupied[level] &= ~((uint64_t) 1 << slot);
+        while (index != NO_SLOT) {
+                uint32_t next = nodes[index].next;
+                link(index);
+                index = next;
+        }
+}
+
+size_t timer_wheel::advance(uint64_t now_ms, std::vector<uint64_t>& expired){
+        size_t fired = 0;
+        while (current < now_ms) {
+                if (armed == 0) {
+                        current = now_ms;
+                        break;
+                }
+
+                // Skip to the next tick that fires a level 0 slot or moves a higher level slot down
+                long wait = next_expiry();
+                if ( current + (uint64_t) wait > now_ms ) {
+                        current = now_ms;
+                        break;
+                }
+                current += (uint64_t) wait;
+
+                // Highest level first, its timers may land in a lower level slot that turns over on this same tick
+                for (int level = TIMER_WHEEL_LEVELS - 1; level > 0; level--) {
+                        if ( (current & (((uint64_t) 1 << (TIMER_WHEEL_BITS * level)) - 1)) == 0 ) {
+                                cascade(level, (uint32_t) ((current >> (TIMER_WHEEL_BITS * level)) & TIMER_WHEEL_MASK));
+                        }
+                }
+
+                uint32_t slot = (uint32_t) (current & TIMER_WHEEL_MASK);
+                uint32_t index = heads[slot];
+                heads[slot] = NO_SLOT;
+                occupied[0] &= ~((uint64_t) 1 << slot);
+                while (index != NO_SLOT) {
+                        uint32_t next = nodes[index].next;
+                        nodes[index].slot = NO_SLOT;
+                        expired.push_back(nodes[index].cookie);
+                        release(index);
+                        fired++;
+                        index = next;
+                }
+        }
+        return fired;
+}
+
+// Earliest of: the next occupied level 0 slot, and the next turn of an occupied slot on every other level
+long timer_wheel::next_expiry(){
+        if (armed == 0) {
+                return -1;
+        }
+        uint64_t best = UINT64_MAX;
+        for (int level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+                uint64_t block = current >> (TIMER_WHEEL_BITS * level);
+                unsigned distance = next_occupied(occupied[level], (unsigned) (block & TIMER_WHEEL_MASK));
+                if (distance == 0) {
+                        continue;
+                }
+                uint64_t at = (block + distance) << (TIMER_WHEEL_BITS * level);
+                if (at < best) {
+                        best = at;
+                }
+        }
+        return (long) (best - current);
+}
+
+size_t timer_wheel::size(){
+        return armed;
+}
+
+uint64_t timer_wheel::now(){
+        return current;
+}
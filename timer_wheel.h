@@ -0,0 +1,108 @@
+//--------------------------
+// Timer wheel module header
+//--------------------------
+// Description:
+// Hierarchical timer wheel with O(1) arm / cancel, for per-connection timeouts on the event loop
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#ifndef _timer_wheel_H_INCLUDED
+#define _timer_wheel_H_INCLUDED
+
+// Default settings
+//-----------------------------
+// Levels of the wheel and slots per level (2^TIMER_WHEEL_BITS), one tick is one millisecond
+// Level n slots are 64^n ms wide, so 5 levels reach 64^5 ms (~12 days), longer delays are capped to that
+#define TIMER_WHEEL_LEVELS 5
+#define TIMER_WHEEL_BITS 6
+#define TIMER_WHEEL_SLOTS (1 << TIMER_WHEEL_BITS)
+//-----------------------------
+
+// Includes
+//-----------------------------
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <time.h>
+//-----------------------------
+
+// Identifies one armed timer, a later timer reusing the slot gets a new generation
+// A default constructed handle never matches a timer
+struct timer_handle
+{
+        uint32_t index = 0;
+        uint32_t generation = 0;
+};
+
+// Millisecond monotonic clock the wheel runs on (coarse clock, no syscall, a few ms resolution)
+inline uint64_t timer_now_ms(){
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+        return (uint64_t) now.tv_sec * 1000 + (uint64_t) now.tv_nsec / 1000000;
+}
+
+// Timers live in a pool and are chained into per-slot lists, so schedule() and cancel() touch a couple of
+// nodes whatever the number of timers. A timer due in d ms sits on the level whose slots are just fine
+// enough for d and moves down a level each time the wheel turns past its slot, firing from level 0
+// advance() only visits slots that hold timers, an idle wheel costs nothing
+// Not thread-safe
+class timer_wheel
+{
+    private:
+        struct timer_node
+        {
+                uint64_t expires;
+                uint64_t cookie;
+                uint32_t next;
+                uint32_t prev;
+                uint32_t generation;
+                // Slot list the node is on (level * TIMER_WHEEL_SLOTS + slot), or NO_SLOT when free
+                uint32_t slot;
+        };
+
+        std::vector<timer_node> nodes;
+        uint32_t free_head;
+        uint32_t heads[TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOTS];
+        // Non-empty slots of each level
+        uint64_t occupied[TIMER_WHEEL_LEVELS];
+        // Time (ms) the wheel has been advanced to
+        uint64_t current = 0;
+        size_t armed = 0;
+
+        void link(uint32_t index);
+        void unlink(uint32_t index);
+        void release(uint32_t index);
+        // Move the timers of one level > 0 slot down to where they belong now
+        void cascade(int level, uint32_t slot);
+
+    public:
+        explicit timer_wheel(uint64_t now_ms = 0);
+
+        // Fire after delay_ms (at least 1 ms from the wheel's current time), advance() reports cookie then
+        timer_handle schedule(uint64_t delay_ms, uint64_t cookie);
+
+        // Stop a timer, false if it already fired or was canceled. Resets handle
+        bool cancel(timer_handle& handle);
+
+        // Timer is armed and hasn't fired yet
+        bool active(timer_handle handle);
+
+        // Move the wheel to now_ms, appending the cookies of timers that came due (in expiry order)
+        // Returns the number appended. Without armed timers the wheel simply jumps ahead
+        size_t advance(uint64_t now_ms, std::vector<uint64_t>& expired);
+
+        // Milliseconds until advance() may have something to do (fire or move timers), -1 if no timer is armed
+        // Use as an upper bound for the event loop's wait
+        long next_expiry();
+
+        size_t size();
+        uint64_t now();
+};
+
+#endif // timer_wheel.h
@@ -0,0 +1,349 @@
+//--------------------------
+// io_uring engine module
+//--------------------------
+// Description:
+// Minimal io_uring driver (raw syscalls, no liburing) used by server_socket
+// Multishot accept, multishot recv into a provided buffer ring, sends from registered buffers
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#include "uring_engine.h"
+
+static int sys_io_uring_setup(unsigned entries, struct io_uring_params* params){
+        return (int) syscall(__NR_io_uring_setup, entries, params);
+}
+
+static int sys_io_uring_enter(int fd, unsigned submit, unsigned min_complete, unsigned flags, void* arg, size_t arg_size){
+        return (int) syscall(__NR_io_uring_enter, fd, submit, min_complete, flags, arg, arg_size);
+}
+
+static int sys_io_uring_register(int fd, unsigned opcode, void* arg, unsigned nr_args){
+        return (int) syscall(__NR_io_uring_register, fd, opcode, arg, nr_args);
+}
+
+static unsigned load_acquire(unsigned* p){
+        return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+static void store_release(unsigned* p, unsigned v){
+        __atomic_store_n(p, v, __ATOMIC_RELEASE);
+}
+
+//-----------------------------
+// Class: uring_engine
+//-----------------------------
+
+uring_engine::uring_engine(){
+}
+
+uring_engine::~uring_engine(){
+        if (ring_fd >= 0) {
+                close(ring_fd);
+        }
+        if (sqes != nullptr) {
+                munmap(sqes, sqes_size);
+        }
+        if (cq_ring != nullptr && cq_ring != sq_ring) {
+                munmap(cq_ring, cq_ring_size);
+        }
+        if (sq_ring != nullptr) {
+                munmap(sq_ring, sq_ring_size);
+        }
+        if (recv_ring != nullptr) {
+                munmap(recv_ring, recv_ring_size);
+        }
+        free(recv_slab);
+        free(send_slab);
+}
+
+// Multishot recv with provided buffer rings needs 6.0, and the ring setup must not be blocked (seccomp, sysctl)
+bool uring_engine::supported(){
+        static const bool result = []() {
+                struct utsname name;
+                if (uname(&name) < 0) {
+                        return false;
+                }
+                int major = 0, minor = 0;
+                if (sscanf(name.release, "%d.%d", &major, &minor) != 2 || major < 6) {
+                        return false;
+                }
+
+                struct io_uring_params params;
+                memset(&params, 0, sizeof(params));
+                int fd = sys_io_uring_setup(4, &params);
+                if (fd < 0) {
+                        return false;
+                }
+                close(fd);
+                return (params.features & IORING_FEAT_EXT_ARG) != 0;
+        }();
+        return result;
+}
+
+int uring_engine::init(unsigned entries, unsigned recv_buffers, unsigned recv_buffer_size,
+                       unsigned send_buffers, unsigned send_buffer_size){
+        struct io_uring_params params;
+        memset(&params, 0, sizeof(params));
+        ring_fd = sys_io_uring_setup(entries, &params);
+        if (ring_fd < 0) {
+                return -1;
+        }
+        sq_entries = params.sq_entries;
+
+        // Map the rings
+        sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+        bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_mmap && cq_ring_size > sq_ring_size) {
+                sq_ring_size = cq_ring_size;
+        }
+        sq_ring = mmap(nullptr, sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQ_RING);
+        if (sq_ring == MAP_FAILED) {
+                sq_ring = nullptr;
+                return -1;
+        }
+        if (single_mmap) {
+                cq_ring = sq_ring;
+                cq_ring_size = sq_ring_size;
+        } else {
+                cq_ring = mmap(nullptr, cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_CQ_RING);
+                if (cq_ring == MAP_FAILED) {
+                        cq_ring = nullptr;
+                        return -1;
+                }
+        }
+        sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+        void* sqe_map = mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQES);
+        if (sqe_map == MAP_FAILED) {
+                return -1;
+        }
+        sqes = (struct io_uring_sqe*) sqe_map;
+
+        char* sq = (char*) sq_ring;
+        sq_head = (unsigned*) (sq + params.sq_off.head);
+        sq_tail = (unsigned*) (sq + params.sq_off.tail);
+        sq_mask = (unsigned*) (sq + params.sq_off.ring_mask);
+        sq_array = (unsigned*) (sq + params.sq_off.array);
+        char* cq = (char*) cq_ring;
+        cq_head = (unsigned*) (cq + params.cq_off.head);
+        cq_tail = (unsigned*) (cq + params.cq_off.tail);
+        cq_mask = (unsigned*) (cq + params.cq_off.ring_mask);
+        cqes = (struct io_uring_cqe*) (cq + params.cq_off.cqes);
+
+        // Provided buffer ring for multishot recv
+        recv_count = recv_buffers;
+        recv_size = recv_buffer_size;
+        recv_ring_size = recv_count * sizeof(struct io_uring_buf);
+        void* ring_map = mmap(nullptr, recv_ring_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ring_map == MAP_FAILED) {
+                return -1;
+        }
+        recv_ring = (struct io_uring_buf_ring*) ring_map;
+        if ( posix_memalign((void**) &recv_slab, 4096, (size_t) recv_count * recv_size) != 0 ) {
+                recv_slab = nullptr;
+                errno = ENOMEM;
+                return -1;
+        }
+        struct io_uring_buf_reg reg;
+        memset(&reg, 0, sizeof(reg));
+        reg.ring_addr = (uint64_t) (uintptr_t) recv_ring;
+        reg.ring_entries = recv_count;
+        reg.bgid = URING_RECV_GROUP;
+        if ( sys_io_uring_register(ring_fd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0 ) {
+                return -1;
+        }
+        for (unsigned bid = 0; bid < recv_count; bid++) {
+                recycle(bid);
+        }
+
+        // Registered (pinned) send buffers
+        send_count = send_buffers;
+        send_size = send_buffer_size;
+        if ( posix_memalign((void**) &send_slab, 4096, (size_t) send_count * send_size) != 0 ) {
+                send_slab = nullptr;
+                errno = ENOMEM;
+                return -1;
+        }
+        std::vector<struct iovec> iov(send_count);
+        for (unsigned i = 0; i < send_count; i++) {
+                iov[i].iov_base = send_slab + (size_t) i * send_size;
+                iov[i].iov_len = send_size;
+                send_free.push_back((int) (send_count - 1 - i));
+        }
+        if ( sys_io_uring_register(ring_fd, IORING_REGISTER_BUFFERS, iov.data(), send_count) < 0 ) {
+                return -1;
+        }
+        return 0;
+}
+
+bool uring_engine::active(){
+        return ring_fd >= 0;
+}
+
+struct io_uring_sqe* uring_engine::get_sqe(){
+        unsigned tail = *sq_tail;
+        if (tail - load_acquire(sq_head) >= sq_entries) {
+                // Ring full, hand what we have to the kernel first
+                if ( enter(to_submit, 0, 0, nullptr, 0) < 0 ) {
+                        return nullptr;
+                }
+                if (tail - load_acquire(sq_head) >= sq_entries) {
+                        errno = EBUSY;
+                        return nullptr;
+                }
+        }
+        unsigned index = tail & *sq_mask;
+        struct io_uring_sqe* sqe = &sqes[index];
+        memset(sqe, 0, sizeof(*sqe));
+        sq_array[index] = index;
+        store_release(sq_tail, tail + 1);
+        to_submit++;
+        return sqe;
+}
+
+int uring_engine::enter(unsigned submit, unsigned min_complete, unsigned flags, void* arg, size_t arg_size){
+        int result;
+        do {
+                result = sys_io_uring_enter(ring_fd, submit, min_complete, flags, arg, arg_size);
+        } while (result < 0 && errno == EINTR);
+        if (result >= 0) {
+                to_submit -= (unsigned) result < to_submit ? (unsigned) result : to_submit;
+        }
+        return result;
+}
+
+int uring_engine::arm_accept(int listen_fd, uint64_t user_data){
+        struct io_uring_sqe* sqe = get_sqe();
+        if (sqe == nullptr) {
+                return -1;
+        }
+        sqe->opcode = IORING_OP_ACCEPT;
+        sqe->fd = listen_fd;
+        sqe->accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+        sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+        sqe->user_data = user_data;
+        return 0;
+}
+
+int uring_engine::arm_recv(int fd, uint64_t user_data){
+        struct io_uring_sqe* sqe = get_sqe();
+        if (sqe == nullptr) {
+                return -1;
+        }
+        sqe->opcode = IORING_OP_RECV;
+        sqe->fd = fd;
+        sqe->flags = IOSQE_BUFFER_SELECT;
+        sqe->buf_group = URING_RECV_GROUP;
+        sqe->ioprio = IORING_RECV_MULTISHOT;
+        sqe->user_data = user_data;
+        return 0;
+}
+
+int uring_engine::send_fixed(int fd, int buffer_index, unsigned length, uint64_t user_data){
+        struct io_uring_sqe* sqe = get_sqe();
+        if (sqe == nullptr) {
+                return -1;
+        }
+        // Plain sends can't use registered buffers, SEND_ZC can (and the buffer stays pinned until
+        // its notification). A socket write() would raise SIGPIPE, both sends take MSG_NOSIGNAL
+        if (send_zerocopy) {
+                sqe->opcode = IORING_OP_SEND_ZC;
+                sqe->ioprio = IORING_RECVSEND_FIXED_BUF;
+                sqe->buf_index = (uint16_t) buffer_index;
+        } else {
+                sqe->opcode = IORING_OP_SEND;
+        }
+        sqe->fd = fd;
+        sqe->addr = (uint64_t) (uintptr_t) send_buffer(buffer_index);
+        sqe->len = length;
+        sqe->msg_flags = MSG_NOSIGNAL;
+        sqe->user_data = user_data;
+        return 0;
+}
+
+int uring_engine::cancel(uint64_t target_user_data){
+        struct io_uring_sqe* sqe = get_sqe();
+        if (sqe == nullptr) {
+                return -1;
+        }
+        sqe->opcode = IORING_OP_ASYNC_CANCEL;
+        sqe->fd = -1;
+        sqe->addr = target_user_data;
+        // Completion of the cancel itself is not interesting
+        sqe->flags = IOSQE_CQE_SKIP_SUCCESS;
+        sqe->user_data = 0;
+        return 0;
+}
+
+char* uring_engine::recv_buffer(unsigned bid){
+        return recv_slab + (size_t) bid * recv_size;
+}
+
+void uring_engine::recycle(unsigned bid){
+        // The ring tail shares memory with bufs[0].resv, so only the buffer fields are written
+        // Entries are indexed from the start of the ring: in C++ the header's flexible array
+        // wrapper (__DECLARE_FLEX_ARRAY) has a 1 byte empty member and recv_ring->bufs lands at offset 8
+        struct io_uring_buf* buf = (struct io_uring_buf*) recv_ring + (recv_tail & (recv_count - 1));
+        buf->addr = (uint64_t) (uintptr_t) recv_buffer(bid);
+        buf->len = recv_size;
+        buf->bid = (uint16_t) bid;
+        recv_tail++;
+        __atomic_store_n(&recv_ring->tail, recv_tail, __ATOMIC_RELEASE);
+}
+
+int uring_engine::acquire_send_buffer(){
+        if ( send_free.empty() ) {
+                return -1;
+        }
+        int buffer_index = send_free.back();
+        send_free.pop_back();
+        return buffer_index;
+}
+
+char* uring_engine::send_buffer(int buffer_index){
+        return send_slab + (size_t) buffer_index * send_size;
+}
+
+void uring_engine::release_send_buffer(int buffer_index){
+        send_free.push_back(buffer_index);
+}
+
+int uring_engine::wait(int timeout, std::vector<uring_completion>& completions){
+        completions.clear();
+
+        // Submit, and sleep only if nothing has completed yet
+        unsigned head = *cq_head;
+        bool ready = (head != load_acquire(cq_tail));
+        if (timeout == 0 || ready) {
+                if ( to_submit > 0 && enter(to_submit, 0, 0, nullptr, 0) < 0 ) {
+                        return -1;
+                }
+        } else {
+                struct __kernel_timespec ts;
+                ts.tv_sec = timeout / 1000;
+                ts.tv_nsec = (long long) (timeout % 1000) * 1000000;
+                struct io_uring_getevents_arg arg;
+                memset(&arg, 0, sizeof(arg));
+                arg.sigmask_sz = _NSIG / 8;
+                arg.ts = (timeout < 0) ? 0 : (uint64_t) (uintptr_t) &ts;
+                if ( enter(to_submit, 1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg)) < 0
+                     && errno != ETIME ) {
+                        return -1;
+                }
+        }
+
+        unsigned tail = load_acquire(cq_tail);
+        while (head != tail) {
+                struct io_uring_cqe* cqe = &cqes[head & *cq_mask];
+                completions.push_back(uring_completion{cqe->user_data, cqe->res, cqe->flags});
+                head++;
+        }
+        store_release(cq_head, head);
+        return (int) completions.size();
+}
@@ -0,0 +1,151 @@
+//--------------------------
+// io_uring engine module header
+//--------------------------
+// Description:
+// Minimal io_uring driver (raw syscalls, no liburing) used by server_socket
+// Multishot accept, multishot recv into a provided buffer ring, sends from registered buffers
+//--------------------------
+// Author: Layne Bernardo
+// Email: lmbernar@uark.edu
+//
+// Created October 17th, 2026
+// Modified: October 17th, 2026
+// Version 0.1
+//--------------------------
+
+#ifndef _uring_engine_H_INCLUDED
+#define _uring_engine_H_INCLUDED
+
+// Default settings
+//-----------------------------
+// Submission queue entries
+#define DEFAULT_URING_ENTRIES 1024
+// Provided receive buffers (power of 2) and their size
+#define DEFAULT_URING_RECV_BUFFERS 1024
+#define DEFAULT_URING_RECV_BUFFER_SIZE 4096
+// Registered send buffers and their size
+#define DEFAULT_URING_SEND_BUFFERS 256
+#define DEFAULT_URING_SEND_BUFFER_SIZE 16384
+// Buffer group id of the provided receive buffers
+#define URING_RECV_GROUP 0
+//-----------------------------
+
+// Includes
+//-----------------------------
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <vector>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <sys/utsname.h>
+#include <unistd.h>
+//-----------------------------
+
+enum io_engine
+{
+        // epoll readiness + read()/sendmsg()
+        ENGINE_EPOLL = 0,
+        // io_uring completions, falls back to epoll if the kernel can't do it
+        ENGINE_URING = 1,
+        // Same as ENGINE_URING
+        ENGINE_AUTO = 2
+};
+
+struct uring_completion
+{
+        uint64_t user_data;
+        int res;
+        uint32_t flags;
+};
+
+class uring_engine
+{
+    private:
+        int ring_fd = -1;
+
+        // Submission ring
+        void* sq_ring = nullptr;
+        size_t sq_ring_size = 0;
+        unsigned* sq_head;
+        unsigned* sq_tail;
+        unsigned* sq_mask;
+        unsigned* sq_array;
+        struct io_uring_sqe* sqes = nullptr;
+        size_t sqes_size = 0;
+        unsigned sq_entries = 0;
+        unsigned to_submit = 0;
+
+        // Completion ring (may share the submission ring's mapping)
+        void* cq_ring = nullptr;
+        size_t cq_ring_size = 0;
+        unsigned* cq_head;
+        unsigned* cq_tail;
+        unsigned* cq_mask;
+        struct io_uring_cqe* cqes;
+
+        // Provided receive buffers
+        struct io_uring_buf_ring* recv_ring = nullptr;
+        size_t recv_ring_size = 0;
+        char* recv_slab = nullptr;
+        unsigned recv_count = 0;
+        unsigned recv_size = 0;
+        uint16_t recv_tail = 0;
+
+        // Registered send buffers
+        char* send_slab = nullptr;
+        unsigned send_count = 0;
+        std::vector<int> send_free;
+
+        struct io_uring_sqe* get_sqe();
+        int enter(unsigned submit, unsigned min_complete, unsigned flags, void* arg, size_t arg_size);
+
+    public:
+        // Size of each registered send buffer
+        unsigned send_size = 0;
+        // Send registered buffers with SEND_ZC, cleared if the socket type doesn't support it
+        bool send_zerocopy = true;
+
+        uring_engine();
+        ~uring_engine();
+
+        uring_engine(const uring_engine&) = delete;
+        uring_engine& operator=(const uring_engine&) = delete;
+
+        // True if the running kernel has everything init() needs (checked once)
+        static bool supported();
+
+        // Set up the rings and buffers, 0 or -1 (errno set)
+        int init(unsigned entries, unsigned recv_buffers, unsigned recv_buffer_size,
+                 unsigned send_buffers, unsigned send_buffer_size);
+
+        bool active();
+
+        // Queue requests, they are submitted by the next wait()
+        int arm_accept(int listen_fd, uint64_t user_data);
+        int arm_recv(int fd, uint64_t user_data);
+        int send_fixed(int fd, int buffer_index, unsigned length, uint64_t user_data);
+        int cancel(uint64_t target_user_data);
+
+        // Provided receive buffer with id bid, and handing it back to the kernel
+        char* recv_buffer(unsigned bid);
+        void recycle(unsigned bid);
+
+        // Registered send buffers, acquire returns -1 if all are in flight
+        int acquire_send_buffer();
+        char* send_buffer(int buffer_index);
+        void release_send_buffer(int buffer_index);
+
+        // Submit queued requests, wait up to timeout ms (-1 = forever) for a completion, reap all completions
+        // Returns number of completions or -1
+        int wait(int timeout, std::vector<uring_completion>& completions);
+};
+
+#endif // uring_engine.h
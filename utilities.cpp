@@ -9,20 +9,13 @@
 // Email: lmbernar@uark.edu
 //
 // Created August 11th, 2018
-// Modified: August 11th, 2018
+// Modified: October 17th, 2026
 // Version 0.1
 //--------------------------
 
 #include "utilities.h"
 
+// Timestamping and output are done by the logger's background thread (see logger.h)
 void console_log(std::string message, std::string caller){
-        time_t rawtime;
-        struct tm * timeinfo;
-
-        time ( &rawtime );
-        timeinfo = localtime ( &rawtime );
-        std::string timestamp = asctime( timeinfo );
-
-        std::cout << "[" << timestamp << "] " << caller << ": ";
-        std::cout << message << std::endl;
+        log_write(LOG_LEVEL_INFO, "%s: %s", caller.c_str(), message.c_str());
 }
@@ -8,7 +8,7 @@
 // Email: lmbernar@uark.edu
 //
 // Created August 11th, 2018
-// Modified: August 11th, 2018
+// Modified: October 17th, 2026
 // Version 0.1
 //--------------------------
 
@@ -22,6 +22,8 @@
 #include <ctime>
 #include <iostream>
 
+#include "logger.h"
+
 void console_log(std::string message, std::string caller = "generic");
 
 #endif // utilities.h